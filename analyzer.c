@@ -34,6 +34,8 @@ bool is_equal_type(Type *lhs, Type *rhs)
 {
   if (!lhs || !rhs)
     unreachable();
+  if (lhs == rhs)  // interned types are equal only if they are the same
+    return true;
   if (is_pointer_type(lhs) && is_pointer_type(rhs))
     return is_equal_type(lhs->ptr_to, rhs->ptr_to);
   if (lhs->type != rhs->type)
@@ -65,39 +67,38 @@ Type *implicit_type_conversion(Type *lhs, Type *rhs)
 {
   // long long > long >  int
   // bool, short, and char are promoted to int through integer promotion
-
-  // long long
-  if (lhs->type == TYPE_LONGLONG || rhs->type == TYPE_LONGLONG)
-  {
-    Type *t = alloc_type(TYPE_LONGLONG);
-    t->is_signed = lhs->is_signed && rhs->is_signed;
-    return t;
-  }
-
-  // long
-  if (lhs->type == TYPE_LONG || rhs->type == TYPE_LONG)
-  {
-    Type *t = alloc_type(TYPE_LONG);
-    t->is_signed = lhs->is_signed && rhs->is_signed;
-    return t;
-  }
-
-  // int
-  if (lhs->type == TYPE_INT || lhs->type == TYPE_ENUM ||
-      rhs->type == TYPE_INT || rhs->type == TYPE_ENUM)
-  {
-    Type *t = alloc_type(TYPE_INT);
-    t->is_signed = lhs->is_signed && rhs->is_signed;
-    return t;
-  }
-
   if (!is_integer_type(lhs) || !is_integer_type(rhs))
     unreachable();
 
-  // integer promotion
-  Type *t = alloc_type(TYPE_INT);
-  t->is_signed = true;
-  return t;
+  TypeKind lhs_kind = lhs->type == TYPE_LONGLONG || lhs->type == TYPE_LONG
+                          ? lhs->type
+                          : TYPE_INT;
+  TypeKind rhs_kind = rhs->type == TYPE_LONGLONG || rhs->type == TYPE_LONG
+                          ? rhs->type
+                          : TYPE_INT;
+  bool lhs_signed = lhs->is_signed || lhs->type != lhs_kind;
+  bool rhs_signed = rhs->is_signed || rhs->type != rhs_kind;
+  if (lhs_kind == rhs_kind)
+    return basic_type(lhs_kind, lhs_signed && rhs_signed);
+
+  // The operand with the greater rank decides the type. If it is signed, it
+  // stays signed only when it can represent all the values of the other one
+  // (C11 6.3.1.8).
+  bool lhs_greater = lhs_kind == TYPE_LONGLONG || rhs_kind == TYPE_INT;
+  TypeKind kind = lhs_greater ? lhs_kind : rhs_kind;
+  bool is_signed = lhs_greater ? lhs_signed : rhs_signed;
+  bool other_signed = lhs_greater ? rhs_signed : lhs_signed;
+  if (size_of_real(lhs_kind) == size_of_real(rhs_kind))
+    is_signed = is_signed && other_signed;
+  return basic_type(kind, is_signed);
+}
+
+// Whether the comparison node compares signed integers. Pointers and the
+// integers whose common type is unsigned are compared as unsigned.
+bool is_signed_comparison(Node *node)
+{
+  return is_integer_type(node->lhs->type) && is_integer_type(node->rhs->type) &&
+         implicit_type_conversion(node->lhs->type, node->rhs->type)->is_signed;
 }
 
 Type *promote_integer(Type *type, Token *token)
@@ -108,9 +109,7 @@ Type *promote_integer(Type *type, Token *token)
   if (type->type == TYPE_BOOL || type->type == TYPE_CHAR ||
       type->type == TYPE_SHORT)
   {
-    Type *promoted_type = alloc_type(TYPE_INT);
-    promoted_type->is_signed = true;
-    return promoted_type;
+    return basic_type(TYPE_INT, true);
   }
   return type;
 }
@@ -237,7 +236,7 @@ static bool check_initializer_type(Type *type, Node *init_list, bool is_root)
     }
     return true;
   }
-  Node *tmp = calloc(1, sizeof(Node));
+  Node *tmp = node_alloc(ND_NOP);
   tmp->type = type;
   add_type_for_assignment(new_node(ND_ASSIGN, tmp, init_list, NULL));
   return true;
@@ -313,14 +312,13 @@ static void add_type_internal(Node *const node)
       {
         // ptr - ptr
         Node *n = new_node(ND_SUB, node->lhs, node->rhs, node->token);
-        n->type = alloc_type(TYPE_LONG);  // sizeof(TYPE_LONG) == sizeof(void*)
+        n->type = basic_type(TYPE_LONG, false);  // sizeof(TYPE_LONG) == sizeof(void*)
         Node *new =
             new_node(ND_DIV, n, new_node_num(size_of(node->lhs->type->ptr_to)),
                      node->token);
-        memcpy(node, new, sizeof(Node));
-        new->rhs->type = alloc_type(TYPE_INT);
-        node->type = alloc_type(TYPE_LONG);
-        node->type->is_signed = false;
+        memcpy(node, new, node_size(new->kind));
+        new->rhs->type = basic_type(TYPE_INT, false);
+        node->type = basic_type(TYPE_LONG, false);
         return;
       }
       if (is_pointer_type(node->lhs->type))
@@ -363,13 +361,21 @@ static void add_type_internal(Node *const node)
     case ND_EQ:
     case ND_NEQ:
     case ND_LT:
-    case ND_LTE: node->type = alloc_type(TYPE_INT); return;
+    case ND_LTE:
+      // Integers are compared in their common type (see is_signed_comparison)
+      if (is_integer_type(node->lhs->type) && is_integer_type(node->rhs->type))
+      {
+        Type *conv_type =
+            implicit_type_conversion(node->lhs->type, node->rhs->type);
+        node->lhs = create_implicit_cast_node(node->lhs, conv_type);
+        node->rhs = create_implicit_cast_node(node->rhs, conv_type);
+      }
+      node->type = basic_type(TYPE_INT, true);
+      return;
     case ND_ASSIGN: add_type_for_assignment(node); return;
     case ND_ADDR:
     {
-      Type *ptr = alloc_type(TYPE_PTR);
-      ptr->ptr_to = node->lhs->type;
-      node->type = ptr;
+      node->type = pointer_to(node->lhs->type);
       return;
     }
     case ND_DEREF:
@@ -390,7 +396,7 @@ static void add_type_internal(Node *const node)
         if (node->kind == ND_UNARY_MINUS || node->kind == ND_NOT)
           error_at(node->token->str, node->token->len,
                    "ND_UNARY_MINUS or ND_NOT must be an integer type.");
-        node->type = alloc_type(TYPE_INT);
+        node->type = basic_type(TYPE_INT, false);
       }
       else
       {
@@ -413,11 +419,11 @@ static void add_type_internal(Node *const node)
       else
         node->num_val = 1;
       return;
-    case ND_FUNCDEF: node->type = alloc_type(TYPE_VOID); return;
+    case ND_FUNCDEF: node->type = basic_type(TYPE_VOID, false); return;
     case ND_FUNCCALL:
     {
       if (!node->type)  // unknown function
-        node->type = alloc_type(TYPE_INT);
+        node->type = basic_type(TYPE_INT, false);
       else
       {
         if (!node->type->param_list)
@@ -451,7 +457,7 @@ static void add_type_internal(Node *const node)
         for (size_t i = 1; i <= fixed_param_count; i++)
         {
           Node *arg_node = vector_peek_at(node->func.expr, i);
-          Node *param_node = calloc(1, sizeof(Node));
+          Node *param_node = node_alloc(ND_NOP);
           param_node->type = vector_peek_at(node->type->param_list, i + 1);
 
           Node *assign_node =
@@ -461,8 +467,6 @@ static void add_type_internal(Node *const node)
           if (assign_node->rhs != arg_node)
             vector_replace_at(node->func.expr, i, assign_node->rhs);
 
-          free(param_node);
-          free(assign_node);
         }
 
         node->type = vector_peek_at(node->type->param_list, 1);
@@ -477,21 +481,19 @@ static void add_type_internal(Node *const node)
         // TODO: check type conversion
         node->lhs = create_implicit_cast_node(node->lhs, ret_type);
       }
-      node->type = alloc_type(TYPE_VOID);
+      node->type = basic_type(TYPE_VOID, false);
     }
       return;
     case ND_SIZEOF:
     {
-      Type *t = alloc_type(TYPE_LONG);
-      t->is_signed = false;
-      node->type = t;
+      node->type = basic_type(TYPE_LONG, false);
       return;
     }
     case ND_IF:
     case ND_ELIF:
     case ND_FOR:
     case ND_WHILE:
-    case ND_DO: node->type = alloc_type(TYPE_VOID); return;
+    case ND_DO: node->type = basic_type(TYPE_VOID, false); return;
     case ND_TERNARY:
     {
       Type *lhs_type = node->control.ternary_child->type;
@@ -543,7 +545,7 @@ static void add_type_internal(Node *const node)
       if (!is_integer_type(rhs) && !is_pointer_type(rhs))
         error_at(node->rhs->token->str, node->rhs->token->len,
                  "Scalar type required.");
-      node->type = alloc_type(TYPE_INT);
+      node->type = basic_type(TYPE_INT, false);
       return;
     }
     case ND_INCLUSIVE_OR:
@@ -593,21 +595,21 @@ static void add_type_internal(Node *const node)
       node->child_offset = offset;
       return;
     }
-    case ND_FIELD: node->type = alloc_type(TYPE_VOID); return;
+    case ND_FIELD: node->type = basic_type(TYPE_VOID, false); return;
     case ND_TYPE_NAME:
     case ND_NUM: return;
-    case ND_BLOCK: node->type = alloc_type(TYPE_VOID); return;
-    case ND_DISCARD_EXPR: node->type = alloc_type(TYPE_VOID); return;
-    case ND_STRING: node->type = alloc_type(TYPE_STR); return;
+    case ND_BLOCK: node->type = basic_type(TYPE_VOID, false); return;
+    case ND_DISCARD_EXPR: node->type = basic_type(TYPE_VOID, false); return;
+    case ND_STRING: node->type = basic_type(TYPE_STR, false); return;
     case ND_GOTO:
     case ND_LABEL:
-    case ND_SWITCH: node->type = alloc_type(TYPE_VOID); return;
+    case ND_SWITCH: node->type = basic_type(TYPE_VOID, false); return;
     case ND_CASE:
     {
       size_t num;
       node->jump.switch_name = switch_add(node, &num);
       node->jump.case_num = num;
-      node->type = alloc_type(TYPE_VOID);
+      node->type = basic_type(TYPE_VOID, false);
       return;
     }
     case ND_COMMA: node->type = node->rhs->type; return;
@@ -649,8 +651,8 @@ static void add_type_internal(Node *const node)
     case ND_SIGN_EXTEND:
     case ND_ZERO_EXTEND:
     case ND_TRUNCATE: return;
-    case ND_EVAL: node->type = alloc_type(TYPE_INT); return;
-    case ND_DECLARATOR_LIST: node->type = alloc_type(TYPE_VOID); return;
+    case ND_EVAL: node->type = basic_type(TYPE_INT, false); return;
+    case ND_DECLARATOR_LIST: node->type = basic_type(TYPE_VOID, false); return;
     case ND_VARIABLE_ARGS:
     case ND_END: unreachable(); break;
   }
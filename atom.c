@@ -0,0 +1,84 @@
+// ------------------------------------------------------------------------------------
+// identifier interning
+// ------------------------------------------------------------------------------------
+
+#include "include/atom.h"
+
+#ifdef SELF_HOST
+#include "test/compiler_header.h"
+#else
+#include <stdlib.h>
+#include <string.h>
+#endif
+
+#define ATOM_TABLE_INITIAL_SIZE 1024  // must be a power of two
+
+static Atom **atom_table;
+static size_t atom_table_size;
+static size_t atom_count;
+
+// FNV-1a hash
+uint32_t atom_hash(char *str, size_t len)
+{
+  uint32_t hash = 2166136261;
+  for (size_t i = 0; i < len; i++)
+  {
+    hash ^= (uint8_t)str[i];
+    hash *= 16777619;
+  }
+  return hash;
+}
+
+// Double the number of buckets and move every atom over
+static void atom_table_grow()
+{
+  size_t new_size = atom_table_size * 2;
+  Atom **new_table = calloc(new_size, sizeof(Atom *));
+  for (size_t i = 0; i < atom_table_size; i++)
+  {
+    Atom *atom = atom_table[i];
+    while (atom)
+    {
+      Atom *next = atom->next;
+      size_t bucket = atom->hash & (new_size - 1);
+      atom->next = new_table[bucket];
+      new_table[bucket] = atom;
+      atom = next;
+    }
+  }
+  free(atom_table);
+  atom_table = new_table;
+  atom_table_size = new_size;
+}
+
+// Return the unique atom for the string of the argument length.
+// The string is copied, so the argument does not have to outlive the atom.
+Atom *atom_intern(char *str, size_t len)
+{
+  if (!atom_table)
+  {
+    atom_table_size = ATOM_TABLE_INITIAL_SIZE;
+    atom_table = calloc(atom_table_size, sizeof(Atom *));
+  }
+  uint32_t hash = atom_hash(str, len);
+  for (Atom *atom = atom_table[hash & (atom_table_size - 1)]; atom;
+       atom = atom->next)
+    if (atom->hash == hash && atom->len == len && !memcmp(atom->str, str, len))
+      return atom;
+
+  if (atom_count >= atom_table_size)
+    atom_table_grow();
+  Atom *new = malloc(sizeof(Atom));
+  new->str = malloc(len + 1);
+  memcpy(new->str, str, len);
+  new->str[len] = '\0';
+  new->len = len;
+  new->hash = hash;
+  new->keyword = 0;
+  new->number_base = 0;
+  size_t bucket = hash & (atom_table_size - 1);
+  new->next = atom_table[bucket];
+  atom_table[bucket] = new;
+  atom_count++;
+  return new;
+}
@@ -41,4 +41,174 @@ END {
 }
 ' > include/include_paths.h
 
-gcc -dM -E - < /dev/null > include/gcc_predef.h
\ No newline at end of file
+gcc -dM -E - < /dev/null > include/gcc_predef.h
+# Table of the predefined macros, tokenized and hashed (FNV-1a, see atom.c)
+# here so that the preprocessor does not have to preprocess them on startup.
+# The built-in macros come first, then the GCC ones used with -g.
+printf '%s\n' '#define __FILE__' '#define __LINE__' '#define __DATE__' \
+    '#define __TIME__' '#define __INCLUDE_LEVEL__' '#define __MYCC__' \
+    '#define SELF_HOST' | awk '
+BEGIN {
+    for (i = 1; i < 256; i++)
+        ord[sprintf("%c", i)] = i
+    punct = "!%&()*+,-./:;<=>?[\\]^{|}~"
+    token_count = 0
+    macro_count = 0
+}
+function xor8(a, b,    r, bit, i) {
+    r = 0
+    bit = 1
+    for (i = 0; i < 8; i++) {
+        if (a % 2 != b % 2)
+            r += bit
+        a = int(a / 2)
+        b = int(b / 2)
+        bit *= 2
+    }
+    return r
+}
+# hash * 16777619 = hash * 403 + hash * 2^24, exact in doubles modulo 2^32
+function fnv(s,    hash, i, low) {
+    hash = 2166136261
+    for (i = 1; i <= length(s); i++) {
+        low = hash % 256
+        hash = hash - low + xor8(low, ord[substr(s, i, 1)])
+        hash = (hash * 403 + (hash % 256) * 16777216) % 4294967296
+    }
+    return hash
+}
+function c_string(s) {
+    gsub(/\\/, "\\\\", s)
+    gsub(/"/, "\\\"", s)
+    return "\"" s "\""
+}
+function add_token(kind, str) {
+    token_kind[token_count] = kind
+    token_str[token_count] = str
+    token_count++
+}
+# Same as punctuator_len() in tokenizer.c
+function punctuator_len(s,    c, d) {
+    c = substr(s, 1, 1)
+    d = substr(s, 2, 1)
+    if (c == "<" || c == ">") {
+        if (d == c)
+            return substr(s, 3, 1) == "=" ? 3 : 2
+        return d == "=" ? 2 : 1
+    }
+    if (c == ".")
+        return substr(s, 1, 3) == "..." ? 3 : 1
+    if (c == "+" || c == "&" || c == "|")
+        return d == c || d == "=" ? 2 : 1
+    if (c == "-")
+        return d == "-" || d == "=" || d == ">" ? 2 : 1
+    if (index("=!*/%^", c))
+        return d == "=" ? 2 : 1
+    return 1
+}
+# Same as tokenize_once() in tokenizer.c for a line without comments
+function tokenize(s,    c, i, len) {
+    while (s != "") {
+        c = substr(s, 1, 1)
+        if (c == " " || c == "\t") {
+            match(s, /^[ \t]+/)
+            add_token("TK_IGNORABLE", substr(s, 1, RLENGTH))
+            s = substr(s, RLENGTH + 1)
+        } else if (c == "#") {
+            add_token("TK_DIRECTIVE", c)
+            s = substr(s, 2)
+        } else if (c == "\"") {
+            for (i = 2; substr(s, i, 1) != "\""; i++)
+                if (substr(s, i, 1) == "\\")
+                    i++
+            add_token("TK_STRING", substr(s, 2, i - 2))
+            s = substr(s, i + 1)
+        } else if (c == "\047") {
+            len = substr(s, 2, 1) == "\\" ? 2 : 1
+            add_token("TK_CHAR", substr(s, 2, len))
+            s = substr(s, len + 3)
+        } else if (c ~ /[A-Za-z0-9_]/) {
+            match(s, /^[A-Za-z0-9_]+/)
+            add_token("TK_IDENT", substr(s, 1, RLENGTH))
+            s = substr(s, RLENGTH + 1)
+        } else if (index(punct, c)) {
+            len = punctuator_len(s)
+            add_token("TK_RESERVED", substr(s, 1, len))
+            s = substr(s, len + 1)
+        } else {
+            print "build.sh: cannot tokenize predefined macro: " s > "/dev/stderr"
+            exit 1
+        }
+    }
+}
+/^[ \t]*#[ \t]*define[ \t]/ {
+    line = $0
+    sub(/^[ \t]*#[ \t]*define[ \t]+/, "", line)
+    match(line, /^[A-Za-z0-9_]+/)
+    name = substr(line, 1, RLENGTH)
+    line = substr(line, RLENGTH + 1)
+    if (name in defined)
+        next
+    defined[name] = 1
+    m = macro_count++
+    macro_name[m] = name
+    macro_gcc[m] = FILENAME == "-" ? "false" : "true"
+    macro_kind[m] = 1
+    macro_parameter[m] = token_count
+    if (substr(line, 1, 1) == "(") {
+        macro_kind[m] = 2
+        i = index(line, ")")
+        n = split(substr(line, 2, i - 2), parameters, ",")
+        for (j = 1; j <= n; j++) {
+            gsub(/[ \t]/, "", parameters[j])
+            if (parameters[j] != "")
+                add_token("TK_IDENT", parameters[j])
+        }
+        line = substr(line, i + 1)
+    }
+    macro_parameter_len[m] = token_count - macro_parameter[m]
+    sub(/^[ \t]+/, "", line)
+    macro_body[m] = token_count
+    tokenize(line)
+    macro_body_len[m] = token_count - macro_body[m]
+}
+END {
+    index_size = 16
+    while (index_size < macro_count * 2)
+        index_size *= 2
+    print "#ifndef PREDEF_TABLE_H"
+    print "#define PREDEF_TABLE_H"
+    print ""
+    print "// Generated by build.sh"
+    print ""
+    print "#define PREDEF_INDEX_SIZE " index_size
+    print ""
+    print "static predef_token predef_tokens[] = {"
+    for (i = 0; i < token_count; i++)
+        print "    {" token_kind[i] ", " length(token_str[i]) ", " c_string(token_str[i]) "},"
+    print "};"
+    print ""
+    print "static predef_macro predef_macros[] = {"
+    for (m = 0; m < macro_count; m++) {
+        hash = fnv(macro_name[m])
+        printf "    {%s, %d, %.0fu, %s, %d, %d, %d, %d, %d},\n", \
+            c_string(macro_name[m]), length(macro_name[m]), hash, macro_gcc[m], \
+            macro_kind[m], macro_parameter[m], macro_parameter_len[m], \
+            macro_body[m], macro_body_len[m]
+        slot = hash % index_size
+        while (slot in slots)
+            slot = (slot + 1) % index_size
+        slots[slot] = m + 1
+    }
+    print "};"
+    print ""
+    print "// Index + 1 of predef_macros by hash (linear probing), 0 if empty"
+    print "static unsigned short predef_index[PREDEF_INDEX_SIZE] = {"
+    for (i = 0; i < index_size; i++)
+        printf "%s%d,%s", (i % 16 ? " " : "    "), (i in slots) ? slots[i] : 0, \
+            (i % 16 == 15 ? "\n" : "")
+    print "};"
+    print ""
+    print "#endif // PREDEF_TABLE_H"
+}
+' - include/gcc_predef.h > include/predef_table.h
@@ -11,11 +11,10 @@
 bool is_builtin_function(Node** node, Token* token, bool is_root)
 {
   (void)is_root;  // unused now
-  *node = calloc(1, sizeof(Node));
-  (**node).token = token;
   if (token && token->len == 7 && !strncmp(token->str, "__asm__", 7))
   {
-    (**node).kind = ND_BUILTINFUNC;
+    *node = node_alloc(ND_BUILTINFUNC);
+    (**node).token = token;
     (**node).func.expr = vector_new();
     (**node).func.builtin_func = FUNC_ASM;
     expect("(", TK_RESERVED);
@@ -0,0 +1,180 @@
+// ------------------------------------------------------------------------------------
+// compilation result cache
+// ------------------------------------------------------------------------------------
+
+#include "include/cache.h"
+
+#ifdef SELF_HOST
+#include "test/compiler_header.h"
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "include/error.h"
+#include "include/file.h"
+#include "include/output.h"
+
+// The generated assembly only depends on the preprocessed tokens, the options
+// given by the caller and the compiler itself, so it is stored in the cache
+// directory under the hash of those:
+//
+//   <dir>/<hash>.s  the assembly
+//   <dir>/hits      one byte appended per cache hit
+//   <dir>/misses    one byte appended per cache miss
+//
+// Entries are written to a temporary file and renamed, and the statistics are
+// appended with O_APPEND, so compilers sharing the directory never see a
+// partial entry or lose a count.
+#define CACHE_KEY_LEN 16  // hex digits of the 64-bit hash
+
+static char *cache_dir;
+static char *entry_path;  // <dir>/<hash>.s of the current input
+static char *temp_path;   // Where the generator writes on a miss
+
+// FNV-1a hash over 64 bits
+static uint64_t cache_hash(uint64_t hash, void *data, size_t len)
+{
+  for (size_t i = 0; i < len; i++)
+  {
+    hash ^= ((uint8_t *)data)[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// Identify the running compiler by the size and the modification time of its
+// executable, so rebuilding the compiler invalidates the cache.
+static uint64_t hash_compiler(uint64_t hash)
+{
+  int fd = open("/proc/self/exe", O_RDONLY);
+  struct stat file_stat;
+  if (fd == -1 || fstat(fd, &file_stat) == -1)
+    error_exit("cannot identify the compiler executable: %s", strerror(errno));
+  close(fd);
+  hash = cache_hash(hash, &file_stat.st_size, sizeof(file_stat.st_size));
+  return cache_hash(hash, &file_stat.st_mtim, sizeof(file_stat.st_mtim));
+}
+
+static char *cache_path(char *name)
+{
+  size_t len = strlen(cache_dir) + strlen(name) + 2;
+  char *path = malloc(len);
+  snprintf(path, len, "%s/%s", cache_dir, name);
+  return path;
+}
+
+static void count(char *name)
+{
+  char *path = cache_path(name);
+  int fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (fd == -1 || write(fd, "+", 1) != 1)
+    error_exit("cannot update %s: %s", path, strerror(errno));
+  close(fd);
+  free(path);
+}
+
+static size_t read_count(char *name)
+{
+  char *path = cache_path(name);
+  int fd = open(path, O_RDONLY);
+  free(path);
+  struct stat file_stat;
+  if (fd == -1)
+    return 0;
+  size_t size = fstat(fd, &file_stat) == -1 ? 0 : file_stat.st_size;
+  close(fd);
+  return size;
+}
+
+// Copy the cache entry to the output file. Returns false if there is no entry.
+static bool copy_entry(char *output_file_name)
+{
+  FILE *fin = fopen(entry_path, "r");
+  if (!fin)
+    return false;
+  char *assembly = file_read(fin);
+  output_open(output_file_name);
+  output_write(assembly, strlen(assembly));
+  output_close();
+  return true;
+}
+
+// Look up the assembly of the preprocessed tokens from token. On a hit it is
+// written to output_file_name and true is returned. On a miss the generator
+// should write to cache_output_file_name() and then call cache_store().
+bool cache_fetch(char *dir, Token *token, uint64_t options,
+                 char *output_file_name)
+{
+  cache_dir = dir;
+  if (mkdir(dir, 0755) == -1 && errno != EEXIST)
+    error_exit("cannot create the cache directory %s: %s", dir,
+               strerror(errno));
+
+  uint64_t hash = (uint64_t)0xcbf29ce4 << 32 | 0x84222325;  // offset basis
+  hash = cache_hash(hash, &options, sizeof(options));
+  hash = hash_compiler(hash);
+  for (; token; token = token->next)
+  {
+    if (token->kind == TK_IGNORABLE || token->kind == TK_ILB ||
+        token->kind == TK_LINEBREAK)
+      continue;
+    hash = cache_hash(hash, &token->kind, sizeof(token->kind));
+    hash = cache_hash(hash, &token->len, sizeof(token->len));
+    hash = cache_hash(hash, token->str, token->len);
+  }
+
+  char name[CACHE_KEY_LEN + 3];
+  snprintf(name, sizeof(name), "%016lx.s", (unsigned long)hash);
+  entry_path = cache_path(name);
+  pr_debug("cache entry: %s", entry_path);
+  if (copy_entry(output_file_name))
+  {
+    count("hits");
+    return true;
+  }
+  count("misses");
+  return false;
+}
+
+// Remove the temporary file of a generator that exited before cache_store()
+static void remove_temp_file()
+{
+  if (temp_path)
+    unlink(temp_path);
+}
+
+char *cache_output_file_name()
+{
+  size_t len = strlen(entry_path) + 24;
+  temp_path = malloc(len);
+  snprintf(temp_path, len, "%s.%d", entry_path, (int)getpid());
+  atexit(remove_temp_file);
+  return temp_path;
+}
+
+// Move the generated assembly into the cache and write it to the output file
+void cache_store(char *output_file_name)
+{
+  if (rename(temp_path, entry_path) == -1)
+    error_exit("cannot store %s: %s", entry_path, strerror(errno));
+  temp_path = NULL;
+  if (!copy_entry(output_file_name))
+    error_exit("cannot read %s", entry_path);
+}
+
+void cache_print_stats(char *dir)
+{
+  cache_dir = dir;
+  size_t hits = read_count("hits");
+  size_t misses = read_count("misses");
+  size_t total = hits + misses;
+  fprintf(stderr, "cache hits: %zu\ncache misses: %zu\nhit rate: %zu%%\n",
+          hits, misses, total ? hits * 100 / total : 0);
+}
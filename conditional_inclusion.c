@@ -3,7 +3,7 @@
 #ifdef SELF_HOST
 #include "test/compiler_header.h"
 #else
-#include <ctype.h>
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 #endif
@@ -16,378 +16,307 @@
 
 static void clean_while_next(Token *head, Token *next);
 
-// Represents the precedence of right-associative operators
-// Smaller values indicate higher precedence
-static size_t operator_precedence(conditional_inclusion_type type)
+// Value of a #if expression: every integer has the type intmax_t or
+// uintmax_t (long long or unsigned long long here)
+typedef struct
 {
-  switch (type)
+  unsigned long long num;  // Two's complement if signed
+  bool is_unsigned;
+} if_value;
+
+static Token *if_token;  // Current token of the #if expression
+static Atom *defined_atom;
+
+static bool is_operator(Token *token, char *op)
+{
+  size_t len = strlen(op);
+  return token->kind == TK_RESERVED && token->len == len &&
+         !memcmp(token->str, op, len);
+}
+
+// Replaces the macros at token (except the operand of defined) and returns
+// the first significant token of the result
+static Token *if_expand(Token *token)
+{
+  while (token->kind == TK_IDENT && token->atom != defined_atom &&
+         ident_replacement(token))
+    if (token->kind == TK_IGNORABLE || token->kind == TK_ILB)
+      token = token_next_not_ignorable(token);  // empty expansion
+  return token;
+}
+
+static void if_advance()
+{
+  if_token = if_expand(token_next_not_ignorable(if_token));
+}
+
+static void if_expect(char *op)
+{
+  if (!is_operator(if_token, op))
+    error_at(if_token->str, if_token->len, "Invalid #if directive.");
+  if_advance();
+}
+
+static if_value if_signed(long long num)
+{
+  if_value value;
+  value.num = num;
+  value.is_unsigned = false;
+  return value;
+}
+
+static if_value if_conditional(bool is_evaluated);
+
+// defined identifier | defined ( identifier )
+static if_value if_defined()
+{
+  Token *token = token_next_not_ignorable(if_token);
+  bool is_brackets = is_operator(token, "(");
+  if (is_brackets)
+    token = token_next_not_ignorable(token);
+  if (token->kind != TK_IDENT)
+    error_at(token->str, token->len, "Invalid defined() use");
+  if_value value = if_signed(find_macro_name_all(token) ? 1 : 0);
+  if (is_brackets)
   {
-    case CPPTK_Question:  // ?
-    case CPPTK_Colon:     // :
-      return 0;
-    case CPPTK_Logical_OR:  // ||
-      return 1;
-    case CPPTK_Logical_AND:  // &&
-      return 2;
-    case CPPTK_Inclusive_OR:  // |
-      return 3;
-    case CPPTK_Exclusive_OR:  // ^
-      return 4;
-    case CPPTK_AND:  // &
-      return 5;
-    case CPPTK_Equality:   // ==
-    case CPPTK_NEquality:  // !=
-      return 6;
-    case CPPTK_LessThan:       // <
-    case CPPTK_LessThanEq:     // <=
-    case CPPTK_GreaterThan:    // >
-    case CPPTK_GreaterThanEq:  // >=
-      return 7;
-    case CPPTK_LeftShift:   // <<
-    case CPPTK_RightShift:  // >>
-      return 8;
-    case CPPTK_Plus:   // +
-    case CPPTK_Minus:  // -
-      return 9;
-    case CPPTK_Mul:          // *
-    case CPPTK_Div:          // /
-    case CPPTK_DivReminder:  // %
-      return 10;
-    case CPPTK_UnaryPlus:   // +
-    case CPPTK_UnaryMinus:  // -
-    case CPPTK_NOT:         // !
-    case CPPTK_Bitwise:     // ~
-      return 11;
-    default: unreachable(); return 0;  // unreachable
+    token = token_next_not_ignorable(token);
+    if (!is_operator(token, ")"))
+      error_at(token->str, token->len, "Invalid defined() use");
   }
+  if_token = token;
+  if_advance();
+  return value;
 }
 
-conditional_inclusion_type reserved_token_to_type(Token *token, bool is_unary)
+static if_value if_primary(bool is_evaluated)
 {
-  if (token->kind != TK_RESERVED)
-    unreachable();
-  if (is_unary)
+  Token *token = if_token;
+  if (is_operator(token, "("))
   {
-    if (token->len != 1)
-      error_at(token->str, token->len, "invalid #if directive");
-    switch (token->str[0])
-    {
-      case '+': return CPPTK_UnaryPlus;
-      case '-': return CPPTK_UnaryMinus;
-      case '!': return CPPTK_NOT;
-      case '~': return CPPTK_Bitwise;
-      case '(': return CPPTK_Parentheses_Start;
-      default: break;
-    }
+    if_advance();
+    if_value value = if_conditional(is_evaluated);
+    if_expect(")");
+    return value;
   }
-  else
+  if (token->kind == TK_CHAR)
   {
-    switch (token->len)
-    {
-      case 1:
-        switch (token->str[0])
-        {
-          case '?': return CPPTK_Question;
-          case ':': return CPPTK_Colon;
-          case '<': return CPPTK_LessThan;
-          case '>': return CPPTK_GreaterThan;
-          case '+': return CPPTK_Plus;
-          case '-': return CPPTK_Minus;
-          case '*': return CPPTK_Mul;
-          case '/': return CPPTK_Div;
-          case '%': return CPPTK_DivReminder;
-          case '&': return CPPTK_AND;
-          case '|': return CPPTK_Inclusive_OR;
-          case '^': return CPPTK_Exclusive_OR;
-          case ')': return CPPTK_Parentheses_End;
-          default: break;
-        }
-        break;
+    char c = token->str[0];
+    if (token->len == 2)
+      switch (token->str[1])
+      {
+        case 'n': c = '\n'; break;
+        case 't': c = '\t'; break;
+        case '0': c = '\0'; break;
+        default: c = token->str[1]; break;  // \\ \' \"
+      }
+    if_advance();
+    return if_signed(c);
+  }
+  if (token->kind != TK_IDENT)
+    error_at(token->str, token->len, "Invalid #if directive.");
+  if (token->atom == defined_atom)
+    return if_defined();
+  if_value value = if_signed(0);  // identifiers left after replacement are 0
+  if ('0' <= token->str[0] && token->str[0] <= '9')
+  {
+    uint8_t suffix;
+    if (!token_number(token, &value.num, &suffix))
+      error_at(token->str, token->len, "cannot convert to integer");
+    // Too large for intmax_t: uintmax_t
+    value.is_unsigned =
+        suffix & NUMBER_UNSIGNED || value.num > (unsigned long long)LLONG_MAX;
+  }
+  if_advance();
+  return value;
+}
 
-      case 2:
-        if (memcmp(token->str, "&&", 2) == 0)
-          return CPPTK_Logical_AND;
-        if (memcmp(token->str, "||", 2) == 0)
-          return CPPTK_Logical_OR;
-        if (memcmp(token->str, "==", 2) == 0)
-          return CPPTK_Equality;
-        if (memcmp(token->str, "!=", 2) == 0)
-          return CPPTK_NEquality;
-        if (memcmp(token->str, "<=", 2) == 0)
-          return CPPTK_LessThanEq;
-        if (memcmp(token->str, ">=", 2) == 0)
-          return CPPTK_GreaterThanEq;
-        if (memcmp(token->str, "<<", 2) == 0)
-          return CPPTK_LeftShift;
-        if (memcmp(token->str, ">>", 2) == 0)
-          return CPPTK_RightShift;
-        break;
-      default: break;
-    }
+static if_value if_unary(bool is_evaluated)
+{
+  if (if_token->kind != TK_RESERVED || if_token->len != 1)
+    return if_primary(is_evaluated);
+  char op = if_token->str[0];
+  if (op != '+' && op != '-' && op != '!' && op != '~')
+    return if_primary(is_evaluated);
+  if_advance();
+  if_value value = if_unary(is_evaluated);
+  switch (op)
+  {
+    case '-': value.num = -value.num; break;
+    case '~': value.num = ~value.num; break;
+    case '!': value = if_signed(!value.num); break;
+    default: break;
   }
-  error_at(token->str, token->len, "invalid #if directive");
-  return CPPTK_Reserved;  // unreachable
+  return value;
 }
 
-Vector *output_list;
+// Precedence of the binary operator token, 0 if it is not one
+static int binary_precedence(Token *token)
+{
+  if (token->kind != TK_RESERVED)
+    return 0;
+  char c = token->str[0];
+  if (token->len == 1)
+    switch (c)
+    {
+      case '|': return 3;
+      case '^': return 4;
+      case '&': return 5;
+      case '<':
+      case '>': return 7;
+      case '+':
+      case '-': return 9;
+      case '*':
+      case '/':
+      case '%': return 10;
+      default: return 0;
+    }
+  if (token->len != 2)
+    return 0;
+  if (c == '|' && token->str[1] == '|')
+    return 1;
+  if (c == '&' && token->str[1] == '&')
+    return 2;
+  if ((c == '=' || c == '!') && token->str[1] == '=')
+    return 6;
+  if ((c == '<' || c == '>') && token->str[1] == '=')
+    return 7;
+  if ((c == '<' || c == '>') && token->str[1] == c)
+    return 8;
+  return 0;
+}
 
-static void shunting_yard_algorithm(Token *token)
+static if_value if_binary_operation(Token *op, if_value lhs, if_value rhs,
+                                    bool is_evaluated)
 {
-  Token *head = token;
-  output_list = vector_new();
-  Vector *operator_stack = vector_new();
-  bool is_unary = true;
-  while (token->kind != TK_LINEBREAK)
+  // The usual arithmetic conversions
+  bool is_unsigned = lhs.is_unsigned || rhs.is_unsigned;
+  unsigned long long l = lhs.num, r = rhs.num;
+  long long sl = l, sr = r;
+  if_value result;
+  result.is_unsigned = is_unsigned;
+  char c = op->str[0];
+  if (op->len == 2 && op->str[1] == '=')
   {
-    if (token->kind == TK_RESERVED)
+    bool is_less = is_unsigned ? l < r : sl < sr;
+    bool is_greater = is_unsigned ? l > r : sl > sr;
+    switch (c)
     {
-      if (token->kind == TK_CHAR)
-      {  // Character processing
-        conditional_inclusion_token *new =
-            malloc(sizeof(conditional_inclusion_token));
-        new->type = CPPTK_Integer;
-        if (token->len == 2)
-        {
-          switch (token->str[1])
-          {
-            case 'n': new->num = '\n'; break;
-            case 't': new->num = '\t'; break;
-            case '\\': new->num = '\\'; break;
-            case '\'': new->num = '\''; break;
-            case '"': new->num = '\"'; break;
-            case '0': new->num = '\0'; break;
-            default: unreachable();
-          }
-        }
-        else
-          new->num = token->next->str[0];
-        vector_push(output_list, new);
-        is_unary = false;
-        token_void(token);
-        token = token_next_not_ignorable_void(token);
-        continue;
-
-        error_at(token->str, token->len, "Invalid #if directive.");
-      }
-      conditional_inclusion_type *type =
-          malloc(sizeof(conditional_inclusion_type));
-      *type = reserved_token_to_type(token, is_unary);
-      if (*type == CPPTK_Parentheses_End || *type == CPPTK_Colon)
-      {
-        conditional_inclusion_type *old = NULL;
-        for (;;)
-        {
-          old = vector_pop(operator_stack);
-          if (*type == CPPTK_Parentheses_End ? *old == CPPTK_Parentheses_Start
-                                             : *old == CPPTK_Question)
-            break;
-          conditional_inclusion_token *new =
-              calloc(1, sizeof(conditional_inclusion_token));
-          new->type = *old;
-          vector_push(output_list, new);
-        }
-        is_unary = *type == CPPTK_Colon;
-        if (*type == CPPTK_Colon)
-          vector_push(operator_stack, type);
-      }
-      else
-      {
-        if (vector_has_data(operator_stack))
-        {
-          conditional_inclusion_type *old = vector_peek(operator_stack);
-          if (*type != CPPTK_Parentheses_Start &&
-              *old != CPPTK_Parentheses_Start)
-          {
-            size_t old_precedence = operator_precedence(*old);
-            size_t type_precedence = operator_precedence(*type);
-            if (old_precedence > type_precedence ||
-                (old_precedence == type_precedence &&
-                 (old_precedence != 0 && old_precedence != 11)))
-            {  // Move from operator_stack to output_list
-              conditional_inclusion_token *new =
-                  calloc(1, sizeof(conditional_inclusion_token));
-              if (old != vector_pop(operator_stack))
-                unreachable();
-              new->type = *old;
-              vector_push(output_list, new);
-            }
-          }
-        }
-        is_unary = true;
-        vector_push(operator_stack, type);
-      }
+      case '=': return if_signed(l == r);
+      case '!': return if_signed(l != r);
+      case '<': return if_signed(!is_greater);
+      default: return if_signed(!is_less);  // >=
     }
-    else
+  }
+  if (op->len == 2 && (c == '<' || c == '>'))
+  {  // Shifts: the type of the left operand
+    result.is_unsigned = lhs.is_unsigned;
+    bool is_left = c == '<';
+    if (!rhs.is_unsigned && sr < 0)
     {
-      conditional_inclusion_token *new =
-          calloc(1, sizeof(conditional_inclusion_token));
-      if (token->len && isdigit(token->str[0]))
-      {
-        bool is_hex = false;
-        if (!strncmp(token->str, "0x", 2))
-          is_hex = true;
-        new->type = CPPTK_Integer;
-        char *tmp;
-        new->num = strtoll(token->str, &tmp, 0);
-        while (*tmp == 'u' || *tmp == 'U' || *tmp == 'l' || *tmp == 'L')
-          tmp++;
-        if (tmp != token->str + token->len + (is_hex ? token->next->len : 0))
-          error_at(token->str, token->len, "cannot convert to integer");
-        if (is_hex)
-          token = token->next;
-      }
-      else if (token->kind == TK_IDENT && token->len == 7 &&
-               !strncmp(token->str, "defined", 7))
-      {
-        new->type = CPPTK_Integer;
-        token = token_next_not_ignorable(token);
-        bool is_brackets = false;
-        if (token->kind == TK_RESERVED && token->str[0] == '(')
-        {
-          is_brackets = true;
-          token = token_next_not_ignorable(token);
-        }
-        pr_debug2("Defined operator found");
-        new->num = find_macro_name_all(token) ? 1 : 0;
-        if (is_brackets)
-        {
-          token = token_next_not_ignorable(token);
-          if (token->kind != TK_RESERVED && token->str[0] == ')')
-            error_at(token->str, token->len, "Invalid defined() use");
-        }
-      }
-      else if (ident_replacement(token))
-      {
-        while (token->kind == TK_IGNORABLE || token->kind == TK_ILB)
-        {
-          token = token->next;
-        }
-        continue;
-      }
-      else if (token->kind == TK_IDENT)
-      {
-        new->type = CPPTK_Integer;
-        new->num = 0;
-      }
-      else
-        error_at(token->str, token->len, "invalid token");
-      vector_push(output_list, new);
-      is_unary = false;
+      is_left = !is_left;
+      r = -r;
     }
-    token = token_next_not_ignorable(token);
+    if (is_left)
+      result.num = r >= 64 ? 0 : l << r;
+    else if (lhs.is_unsigned)
+      result.num = r >= 64 ? 0 : l >> r;
+    else
+      result.num = sl >> (r >= 64 ? 63 : r);
+    return result;
   }
-  while (vector_has_data(operator_stack))
+  switch (c)
   {
-    conditional_inclusion_token *new =
-        calloc(1, sizeof(conditional_inclusion_token));
-    new->type = *(conditional_inclusion_type *)(vector_pop(operator_stack));
-    vector_push(output_list, new);
+    case '|': result.num = l | r; break;
+    case '^': result.num = l ^ r; break;
+    case '&': result.num = l & r; break;
+    case '<': return if_signed(is_unsigned ? l < r : sl < sr);
+    case '>': return if_signed(is_unsigned ? l > r : sl > sr);
+    case '+': result.num = l + r; break;
+    case '-': result.num = l - r; break;
+    case '*': result.num = l * r; break;
+    case '/':
+    case '%':
+      if (!r)
+      {
+        if (is_evaluated)
+          error_at(op->str, op->len, "Division by zero in #if directive.");
+        result.num = 0;
+      }
+      else if (is_unsigned)
+        result.num = c == '/' ? l / r : l % r;
+      else if (sl == LLONG_MIN && sr == -1)  // overflows
+        result.num = c == '/' ? l : 0;
+      else
+        result.num = c == '/' ? sl / sr : sl % sr;
+      break;
+    default: unreachable();
   }
-  vector_free(operator_stack);
-  clean_while_next(head, token);
+  return result;
 }
 
-static bool reverse_polish_notation_stack_machine()
+// Precedence climbing over the binary operators of at least min_precedence.
+// The operands that are not evaluated (the right-hand side of && and || when
+// the left-hand side decides the result) do not report division by zero.
+static if_value if_binary(int min_precedence, bool is_evaluated)
 {
-  Vector *stack = vector_new();
-  while (vector_has_data(output_list))
+  if_value lhs = if_unary(is_evaluated);
+  for (;;)
   {
-    conditional_inclusion_token *token = vector_shift(output_list);
-    switch (token->type)
+    Token *op = if_token;
+    int precedence = binary_precedence(op);
+    if (!precedence || precedence < min_precedence)
+      return lhs;
+    if_advance();
+    if (precedence <= 2)
+    {  // || &&
+      bool is_or = precedence == 1;
+      bool is_decided = is_or ? lhs.num != 0 : lhs.num == 0;
+      if_value rhs = if_binary(precedence + 1, is_evaluated && !is_decided);
+      lhs = if_signed(is_or ? lhs.num || rhs.num : lhs.num && rhs.num);
+    }
+    else
     {
-      case CPPTK_Integer: vector_push(stack, token); continue;
-      case CPPTK_UnaryPlus:
-      case CPPTK_UnaryMinus:
-      case CPPTK_NOT:
-      case CPPTK_Bitwise:
-      {  // Unary right-associative
-        conditional_inclusion_token *tmp = vector_pop(stack);
-        if (tmp->type != CPPTK_Integer)
-          error_exit("Invalid #if directive.");
-        switch (token->type)
-        {
-          case CPPTK_UnaryPlus: break;
-          case CPPTK_UnaryMinus: tmp->num = -tmp->num; break;
-          case CPPTK_NOT: tmp->num = !tmp->num; break;
-          case CPPTK_Bitwise: tmp->num = ~tmp->num; break;
-          default: unreachable(); break;
-        }
-        vector_push(stack, tmp);
-      }
-        continue;
-      case CPPTK_Question: unreachable(); break;
-      case CPPTK_Colon:  // Binary operator
-      {
-        conditional_inclusion_token *left_hand_side = vector_pop(stack);
-        conditional_inclusion_token *middle_hand_side = vector_pop(stack);
-        conditional_inclusion_token *right_hand_side = vector_pop(stack);
-        if (left_hand_side->type != CPPTK_Integer ||
-            middle_hand_side->type != CPPTK_Integer ||
-            right_hand_side->type != CPPTK_Integer)
-          error_exit("Invalid #if directive.");
-        left_hand_side->num =
-            left_hand_side->num ? middle_hand_side->num : right_hand_side->num;
-        vector_push(stack, left_hand_side);
-      }
-        continue;
-      default:  // Binary left-associative operator
-      {
-        conditional_inclusion_token *lhs = vector_pop(stack);
-        conditional_inclusion_token *rhs = vector_pop(stack);
-        if (lhs->type != CPPTK_Integer || rhs->type != CPPTK_Integer)
-          error_exit("Invalid #if directive.");
-        switch (token->type)
-        {
-          case CPPTK_Logical_OR: rhs->num = rhs->num || lhs->num; break;
-          case CPPTK_Logical_AND: rhs->num = rhs->num && lhs->num; break;
-          case CPPTK_Inclusive_OR: rhs->num = rhs->num | lhs->num; break;
-          case CPPTK_Exclusive_OR: rhs->num = rhs->num ^ lhs->num; break;
-          case CPPTK_AND: rhs->num = rhs->num & lhs->num; break;
-          case CPPTK_Equality: rhs->num = rhs->num == lhs->num; break;
-          case CPPTK_NEquality: rhs->num = rhs->num != lhs->num; break;
-          case CPPTK_LessThan: rhs->num = rhs->num < lhs->num; break;
-          case CPPTK_LessThanEq: rhs->num = rhs->num <= lhs->num; break;
-          case CPPTK_GreaterThan: rhs->num = rhs->num > lhs->num; break;
-          case CPPTK_GreaterThanEq: rhs->num = rhs->num >= lhs->num; break;
-          case CPPTK_LeftShift: rhs->num = rhs->num << lhs->num; break;
-          case CPPTK_RightShift: rhs->num = rhs->num >> lhs->num; break;
-          case CPPTK_Plus: rhs->num = rhs->num + lhs->num; break;
-          case CPPTK_Minus: rhs->num = rhs->num - lhs->num; break;
-          case CPPTK_Mul: rhs->num = rhs->num * lhs->num; break;
-          case CPPTK_Div: rhs->num = rhs->num / lhs->num; break;
-          case CPPTK_DivReminder: rhs->num = rhs->num % lhs->num; break;
-          default: unreachable(); break;
-        }
-        vector_push(stack, rhs);
-      }
-        continue;
+      if_value rhs = if_binary(precedence + 1, is_evaluated);
+      lhs = if_binary_operation(op, lhs, rhs, is_evaluated);
     }
   }
-  bool result = ((conditional_inclusion_token *)vector_pop(stack))->num;
-  if (vector_has_data(stack))
-    error_exit("Invalid #if directive.");
+}
+
+// conditional = binary ( "?" conditional ":" conditional )?
+static if_value if_conditional(bool is_evaluated)
+{
+  if_value condition = if_binary(1, is_evaluated);
+  if (!is_operator(if_token, "?"))
+    return condition;
+  if_advance();
+  if_value then_value = if_conditional(is_evaluated && condition.num);
+  if_expect(":");
+  if_value else_value = if_conditional(is_evaluated && !condition.num);
+  if_value result = condition.num ? then_value : else_value;
+  result.is_unsigned = then_value.is_unsigned || else_value.is_unsigned;
   return result;
 }
 
 /**
  *  C preprocessor #if expression interpreter
  *
- *  using Shunting-yard algorithm
+ *  Evaluates the tokens in a single pass by precedence climbing. The macros
+ *  are replaced as the tokens are read.
  *
  *  EBNF:
  *  expression  = conditional
- *  conditional = logical_or ( "?" expression ":" expression )?
- *  logical_or = logical_and ( "||" logical_and )?
- *  logical_and = inclusive_or ( "&&" inclusive_or )?
- *  inclusive_or = exclusive_or ( "|" exclusive_or)?
- *  exclusive_or = and ( "^" and )?
- *  and = equality ( "&" equality )?
- *  equality = relational ( "==" relational | "!=" relational)?
- *  relational = shift ( "<" shift | ">" shift | "<=" shift | ">=" shift )?
- *  shift = additive ( "<<" additive | ">>" additive )?
- *  additive = multiplicative ( "+" multiplicative | "-" multiplicative )?
- *  multiplicative = unary ( "*" unary | "/" unary | "%" unary )?
- *  unary = ( "+" | "-" | "!" | "~" )? primary
+ *  conditional = logical_or ( "?" expression ":" conditional )?
+ *  logical_or = logical_and ( "||" logical_and )*
+ *  logical_and = inclusive_or ( "&&" inclusive_or )*
+ *  inclusive_or = exclusive_or ( "|" exclusive_or )*
+ *  exclusive_or = and ( "^" and )*
+ *  and = equality ( "&" equality )*
+ *  equality = relational ( "==" relational | "!=" relational )*
+ *  relational = shift ( "<" shift | ">" shift | "<=" shift | ">=" shift )*
+ *  shift = additive ( "<<" additive | ">>" additive )*
+ *  additive = multiplicative ( "+" multiplicative | "-" multiplicative )*
+ *  multiplicative = unary ( "*" unary | "/" unary | "%" unary )*
+ *  unary = ( "+" | "-" | "!" | "~" ) unary | primary
  *  primary = integer |
  *            char |
  *            "(" expression ")" |
@@ -398,21 +327,14 @@ static bool reverse_polish_notation_stack_machine()
 bool condition_interpreter(Token *head)
 {
   pr_debug2("start #if token %.*s", head->len, head->str);
-#ifdef DEBUG
-  pr_debug("Condition interpreter");
-  Token *ptr = head;
-  while (ptr->kind != TK_LINEBREAK)
-  {
-    printf("%.*s", (int)ptr->len, ptr->str);
-    ptr = ptr->next;
-  }
-  printf("\n");
-#endif
-  shunting_yard_algorithm(head);
-#ifdef DEBUG
-  print_polish_notation();
-#endif
-  return reverse_polish_notation_stack_machine();
+  if (!defined_atom)
+    defined_atom = atom_intern("defined", 7);
+  if_token = if_expand(head);
+  bool result = if_conditional(true).num != 0;
+  if (if_token->kind != TK_LINEBREAK)
+    error_at(if_token->str, if_token->len, "Invalid #if directive.");
+  clean_while_next(head, if_token);
+  return result;
 }
 
 // Deletes tokens from the head token to the next token in the argument.
@@ -429,123 +351,159 @@ static void clean_while_next(Token *head, Token *next)
   }
 }
 
-static void _conditional_inclusion(if_directive type, Token *head,
-                                   Vector *conditional_list);
+// Deletes the rest of the directive line from head and returns the
+// TK_LINEBREAK at the end of it
+static Token *clean_line(Token *head)
+{
+  Token *linebreak = head;
+  while (linebreak->kind != TK_LINEBREAK)
+  {
+    if (linebreak->kind == TK_EOF)
+      error_exit("#if directive is not closed.");
+    linebreak = linebreak->next;
+  }
+  clean_while_next(head, linebreak);
+  return linebreak;
+}
 
-// Function to process #else #elif #endif etc. corresponding to #if #ifdef
-// #ifndef
-void next_conditional_inclusion(Token *token, bool is_true,
-                                Vector *conditional_list, bool is_end)
+// Evaluates the condition of #if #ifdef #ifndef (and #elif #elifdef
+// #elifndef) starting at head. *linebreak is set to the end of the line.
+static bool evaluate_condition(if_directive type, Token *head,
+                               Token **linebreak)
 {
-  switch (token->len)
+  bool is_true;
+  switch (type)
   {
-    case 4:  // #else #elif
-      if (!strncmp(token->str, "else", 4))
-      {  // #else
-        Token *next = vector_shift(conditional_list);
-        token_void(next);
-        next = token_next_not_ignorable_void(next);
-        token_void(token);
-        if (is_true)
-          clean_while_next(token, next);
-        next_conditional_inclusion(next, !is_true, conditional_list, true);
-      }
-      else
-      {  // #elif
-        if (is_end)
-          error_at(token->str, token->len, "Invalid #elif use");
-        if (!is_true)
-          _conditional_inclusion(token_if, token, conditional_list);
-        else
-        {
-          Token *next = vector_shift(conditional_list);
-          token_void(next);
-          next = token_next_not_ignorable_void(next);
-          clean_while_next(token, next);
-          next_conditional_inclusion(next, is_true, conditional_list, false);
-        }
-      }
+    case token_if:
+    case token_elif:
+      if (head->kind == TK_LINEBREAK)
+        error_at(head->str, head->len, "Invalid #if directive.");
+      is_true = condition_interpreter(head);
       break;
-    case 5:  // #endif
-      token_void(token);
-      token_next_not_ignorable_void(token);
-      return;
-    case 7:  // #elifdef
-    case 8:  // #elifndef
-      if (is_end)
-        error_at(token->str, token->len, "Invalid #elifdef use");
-      if (!is_true)
-      {
-        if (token->len == 8)  // #elifdef
-          _conditional_inclusion(token_ifdef, token, conditional_list);
-        else  // #elifndef
-          _conditional_inclusion(token_ifndef, token, conditional_list);
-      }
-      else
-      {
-        Token *next = vector_shift(conditional_list);
-        token_void(next);
-        next = token_next_not_ignorable_void(next);
-        clean_while_next(token, next);
-        next_conditional_inclusion(next, is_true, conditional_list, false);
-      }
-      token_void(token);
+    case token_ifdef:
+    case token_ifndef:
+    case token_elifdef:
+    case token_elifndef:
+      if (head->kind != TK_IDENT)
+        error_at(head->str, head->len, "Invalid #ifdef directive.");
+      is_true = find_macro_name_all(head) ? type == token_ifdef ||
+                                                type == token_elifdef
+                                          : type == token_ifndef ||
+                                                type == token_elifndef;
       break;
-    default: unreachable(); break;
+    default: unreachable();
   }
+  *linebreak = clean_line(head);
+  return is_true;
 }
 
-static void _conditional_inclusion(if_directive type, Token *head,
-                                   Vector *conditional_list)
+// Returns the macro of an include guard candidate: GUARD of "#ifndef GUARD",
+// "#if !defined GUARD" or "#if !defined(GUARD)" (head is the token after the
+// directive name). Otherwise returns NULL.
+static Atom *guard_macro(if_directive type, Token *head)
 {
-  switch (type)
+  Token *guard = head;
+  if (type == token_if)
   {
-    case token_if:
+    if (head->kind != TK_RESERVED || head->len != 1 || head->str[0] != '!')
+      return NULL;
+    Token *defined = token_next_not_ignorable(head);
+    if (defined->kind != TK_IDENT ||
+        defined->atom != atom_intern("defined", 7))
+      return NULL;
+    guard = token_next_not_ignorable(defined);
+    bool is_brackets = guard->kind == TK_RESERVED && guard->len == 1 &&
+                       guard->str[0] == '(';
+    if (is_brackets)
+      guard = token_next_not_ignorable(guard);
+    Token *end = token_next_not_ignorable(guard);
+    if (is_brackets)
     {
-      token_void(head);
-      head = token_next_not_ignorable_void(head);
-      bool is_true = condition_interpreter(head);
-      Token *next = vector_shift(conditional_list);
-      token_void(next);
-      next = token_next_not_ignorable_void(next);
-      if (!is_true)
-        clean_while_next(head, next);
-      next_conditional_inclusion(next, is_true, conditional_list, false);
+      if (end->kind != TK_RESERVED || end->len != 1 || end->str[0] != ')')
+        return NULL;
+      end = token_next_not_ignorable(end);
     }
-    break;
+    if (end->kind != TK_LINEBREAK)
+      return NULL;
+  }
+  else if (type != token_ifndef)
+    return NULL;
+  return guard->kind == TK_IDENT ? guard->atom : NULL;
+}
+
+// Processes a conditional directive. token is the directive name following
+// '#'. The groups of the current file that are still open are kept in
+// Conditional_Inclusion_List. When a group is not included, it is skipped
+// as raw text by skip_group() without being tokenized.
+Token *conditional_inclusion(if_directive type, Token *token)
+{
+  token_void(token);
+  Token *head = token_next_not_ignorable_void(token);
+  Token *linebreak;
+  conditional_group *group;
+  switch (type)
+  {
+    case token_if:
     case token_ifdef:
     case token_ifndef:
-    {
-      token_void(head);
-      head = token_next_not_ignorable_void(head);
-      bool is_true = false;
-      if (find_macro_name_all(head))
-      {
-        if (type == token_ifdef)
-          is_true = true;
+      group = calloc(1, sizeof(conditional_group));
+      vector_push(Conditional_Inclusion_List, group);
+      if (File_Guard_State == GUARD_START)
+      {  // #ifndef GUARD or #if !defined(GUARD) first in the file
+        File_Guard = guard_macro(type, head);
+        if (File_Guard)
+        {
+          group->is_guard = true;
+          File_Guard_State = GUARD_IN_GROUP;
+        }
       }
-      else if (type == token_ifndef)
-        is_true = true;
-      token_void(head);
-      head = head->next;
-
-      // Corresponding directives like #else #endif
-      Token *next = vector_shift(conditional_list);
-      token_void(next);
-      next = token_next_not_ignorable_void(next);
-      if (!is_true)
-        clean_while_next(head, next);
-      next_conditional_inclusion(next, is_true, conditional_list, false);
-    }
-    break;
+      group->is_included = evaluate_condition(type, head, &linebreak);
+      if (!group->is_included)
+        skip_group(linebreak);
+      break;
+    case token_elif:
+    case token_elifdef:
+    case token_elifndef:
+      if (!vector_has_data(Conditional_Inclusion_List))
+        error_at(head->str, head->len, "Invalid #elif use");
+      group = vector_peek(Conditional_Inclusion_List);
+      if (group->has_else)
+        error_at(head->str, head->len, "Invalid #elif use");
+      if (group->is_guard)
+        File_Guard_State = GUARD_NONE;
+      if (group->is_included)
+      {  // An earlier group has been included
+        skip_group(clean_line(head));
+        break;
+      }
+      group->is_included = evaluate_condition(type, head, &linebreak);
+      if (!group->is_included)
+        skip_group(linebreak);
+      break;
+    case token_else:
+      if (!vector_has_data(Conditional_Inclusion_List))
+        error_at(head->str, head->len, "Invalid #else use");
+      group = vector_peek(Conditional_Inclusion_List);
+      if (group->has_else)
+        error_at(head->str, head->len, "Invalid #else use");
+      if (group->is_guard)
+        File_Guard_State = GUARD_NONE;
+      group->has_else = true;
+      linebreak = clean_line(head);
+      if (group->is_included)
+        skip_group(linebreak);
+      group->is_included = true;
+      break;
+    case token_endif:
+      if (!vector_has_data(Conditional_Inclusion_List))
+        error_at(head->str, head->len, "Invalid #endif use");
+      group = vector_pop(Conditional_Inclusion_List);
+      if (group->is_guard && File_Guard_State == GUARD_IN_GROUP)
+        File_Guard_State = GUARD_AFTER_GROUP;
+      free(group);
+      clean_line(head);
+      break;
     default: unreachable();
   }
+  return token;
 }
-
-void conditional_inclusion(if_directive type, Vector *conditional_list)
-{
-  Token *head = vector_shift(conditional_list);
-  token_void(head);
-  head = token_next_not_ignorable_void(head);
-  _conditional_inclusion(type, head, conditional_list);
-}
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <assert.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #endif
 
 #include "include/analyzer.h"
@@ -18,7 +19,6 @@
 #include "include/type.h"
 
 extern GTLabel *head_label;
-extern Vector *output_list;
 
 // for calling with gdb
 void print_token_str(Vector *vec)
@@ -32,21 +32,30 @@ void print_token_str(Vector *vec)
   pr_debug("\nEnd");
 }
 
-static char *CPPTKlist[CPPTK_Reserved] = {CPPTK_list};
-
-void print_polish_notation()
+// Measure the throughput of tokenize_once() over the whole input.
+// The input is lexed repeatedly for at least one second and the result is
+// reported in MB/s.
+void bench_tokenizer(char *input)
 {
-  pr_debug("Polish notation:");
-  printf("vector size: %lu\n", vector_size(output_list));
-  for (size_t i = 1; i <= vector_size(output_list); i++)
+  size_t input_size = strlen(input);
+  size_t iterations = 0;
+  long elapsed_ns;
+  struct timespec start, now;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  do
   {
-    conditional_inclusion_token *token = vector_peek_at(output_list, i);
-    printf("%s", CPPTKlist[token->type]);
-    if (token->type == CPPTK_Integer)
-      printf(": %lld\n", token->num);
-    printf("\n");
-  }
-  pr_debug("End polish notation");
+    char *ptr = input;
+    while (*ptr)
+      tokenize_once(ptr, &ptr);
+    token_arena_free();
+    iterations++;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    elapsed_ns = (now.tv_sec - start.tv_sec) * 1000000000L +
+                 (now.tv_nsec - start.tv_nsec);
+  } while (elapsed_ns < 1000000000L);
+  printf("tokenizer: %zu bytes x %zu iterations in %ld ms: %zu MB/s\n",
+         input_size, iterations, elapsed_ns / 1000000,
+         input_size * iterations * 1000 / elapsed_ns);
 }
 
 void print_tokenize_result(Token *token)
@@ -54,7 +63,7 @@ void print_tokenize_result(Token *token)
   pr_debug("Tokenize result:");
   for (;;)
   {
-    if (token->kind == TK_EOF)
+    if (!token || token->kind == TK_EOF)
       break;
     printf("%.*s\t: %s\n", (int)token->len, token->str,
            tokenkindlist[token->kind]);
@@ -499,9 +508,11 @@ void print_definition()
 {
   pr_debug("Definition:");
   printf("Object-like macro:\n");
-  for (size_t i = 1; i <= vector_size(object_like_macro_list); i++)
+  for (size_t i = 0; i < macro_table_size; i++)
   {
-    object_like_macro_storage *tmp = vector_peek_at(object_like_macro_list, i);
+    if (macro_table[i].kind != 1 || !macro_table[i].macro)
+      continue;
+    object_like_macro_storage *tmp = macro_table[i].macro;
     printf("  %.*s: ", (int)tmp->identifier->len, tmp->identifier->str);
     for (size_t j = 1; j <= vector_size(tmp->token_string); j++)
     {
@@ -511,10 +522,11 @@ void print_definition()
     printf("\n");
   }
   printf("Function-like macro:\n");
-  for (size_t i = 1; i <= vector_size(function_like_macro_list); i++)
+  for (size_t i = 0; i < macro_table_size; i++)
   {
-    function_like_macro_storage *tmp =
-        vector_peek_at(function_like_macro_list, i);
+    if (macro_table[i].kind != 2 || !macro_table[i].macro)
+      continue;
+    function_like_macro_storage *tmp = macro_table[i].macro;
     printf("  %.*s(", (int)tmp->identifier->len, tmp->identifier->str);
     for (size_t j = 1; j <= vector_size(tmp->arguments); j++)
     {
@@ -18,126 +18,839 @@
 #include "include/tokenizer.h"
 #include "include/vector.h"
 
-Vector *object_like_macro_list;
-Vector *function_like_macro_list;
+// Macro table: open addressing with linear probing, keyed by the atom of the
+// macro name. Once a name has a slot it keeps it: #undef only clears the
+// macro, so no tombstones are needed.
+macro_slot *macro_table;
+size_t macro_table_size;         // Number of slots (power of two)
+static size_t macro_table_used;  // Number of slots whose name is set
 
-int find_macro_name_without_hide_set(Token *identifier, Vector *hide_set,
+#define MACRO_TABLE_INITIAL_SIZE 1024
+
+// Returns the slot of name, or the empty slot where it should be inserted
+static macro_slot *macro_table_find(Atom *name)
+{
+  size_t mask = macro_table_size - 1;
+  size_t i = name->hash & mask;
+  while (macro_table[i].name && macro_table[i].name != name)
+    i = (i + 1) & mask;
+  return &macro_table[i];
+}
+
+// Returns the slot of name, creating it if needed
+static macro_slot *macro_table_insert(Atom *name)
+{
+  if ((macro_table_used + 1) * 2 > macro_table_size)
+  {  // Keep the load factor at most 1/2
+    macro_slot *old_table = macro_table;
+    size_t old_size = macro_table_size;
+    macro_table_size = old_size ? old_size * 2 : MACRO_TABLE_INITIAL_SIZE;
+    macro_table = calloc(macro_table_size, sizeof(macro_slot));
+    macro_table_used = 0;
+    for (size_t i = 0; i < old_size; i++)
+      if (old_table[i].name)  // #undef'd names too, see macro_table_lookup()
+      {
+        *macro_table_find(old_table[i].name) = old_table[i];
+        macro_table_used++;
+      }
+    free(old_table);
+  }
+  macro_slot *slot = macro_table_find(name);
+  if (!slot->name)
+  {
+    slot->name = name;
+    macro_table_used++;
+  }
+  return slot;
+}
+
+// Predefined macros, tokenized and hashed by build.sh
+// (include/predef_table.h). Nothing is done for them on startup: the first
+// lookup of a name copies its predefined macro into the macro table, where it
+// can be redefined or #undef'd like any other macro.
+typedef struct
+{
+  TokenKind kind;
+  uint32_t len;
+  char *str;
+} predef_token;
+
+typedef struct
+{
+  char *name;
+  uint32_t len;
+  uint32_t hash;  // atom_hash() of name
+  bool is_gcc;    // Defined only with -g
+  int kind;       // 1: object-like macro, 2: function-like macro
+  uint32_t parameter;  // First parameter in predef_tokens
+  uint32_t parameter_len;
+  uint32_t body;  // First token of the replacement list in predef_tokens
+  uint32_t body_len;
+} predef_macro;
+
+#include "include/predef_table.h"
+
+static bool predef_enabled;
+static bool predef_gcc;
+
+// Enable the predefined macros, including the GCC ones if gcc_compatible
+void define_predefined_macros(bool gcc_compatible)
+{
+  predef_enabled = true;
+  predef_gcc = gcc_compatible;
+}
+
+static void push_predef_tokens(Vector *vec, uint32_t start, uint32_t len)
+{
+  for (uint32_t i = start; i < start + len; i++)
+  {
+    Token *token = token_alloc();
+    token->kind = predef_tokens[i].kind;
+    token->len = predef_tokens[i].len;
+    token->str = predef_tokens[i].str;
+    if (token->kind == TK_IDENT)
+    {
+      token->atom = atom_intern(token->str, token->len);
+      if ('0' <= *token->str && *token->str <= '9')
+        token_number(token, NULL, NULL);  // as the tokenizer does
+    }
+    vector_push(vec, token);
+  }
+}
+
+// Copy the predefined macro of name into the macro table.
+// Returns false if name is not a predefined macro.
+static bool predef_load(Atom *name)
+{
+  if (!predef_enabled)
+    return false;
+  size_t mask = PREDEF_INDEX_SIZE - 1;
+  for (size_t i = name->hash & mask; predef_index[i]; i = (i + 1) & mask)
+  {
+    predef_macro *predef = &predef_macros[predef_index[i] - 1];
+    if (predef->hash != name->hash || predef->len != name->len ||
+        memcmp(predef->name, name->str, name->len))
+      continue;
+    if (predef->is_gcc && !predef_gcc)
+      return false;
+    macro_table_insert(name);  // so that add_*_macro() does not load again
+    Vector *token_list = vector_new();
+    Token *identifier = token_alloc();
+    identifier->kind = TK_IDENT;
+    identifier->str = name->str;
+    identifier->len = name->len;
+    identifier->atom = name;
+    vector_push(token_list, identifier);
+    if (predef->kind == 2)
+    {
+      Vector *arguments = vector_new();
+      push_predef_tokens(arguments, predef->parameter, predef->parameter_len);
+      vector_push(token_list, arguments);
+    }
+    push_predef_tokens(token_list, predef->body, predef->body_len);
+    if (predef->kind == 1)
+      add_object_like_macro(token_list);
+    else
+      add_function_like_macro(token_list);
+    return true;
+  }
+  return false;
+}
+
+// Returns the slot of name, or NULL if name has never been defined.
+// The predefined macro of name is loaded on its first lookup.
+static macro_slot *macro_table_lookup(Atom *name)
+{
+  if (macro_table)
+  {
+    macro_slot *slot = macro_table_find(name);
+    if (slot->name)
+      return slot;
+  }
+  return predef_load(name) ? macro_table_find(name) : NULL;
+}
+
+// Hide set (Prosser's algorithm): every token made by a macro expansion
+// carries the names of the macros it came from (token_hide_set()) and is not
+// expanded by them again. Hide sets are immutable and share their tails, so
+// adding a name is one allocation and nested expansions never copy a set.
+struct HideSet
+{
+  Atom *name;
+  HideSet *next;
+  uint64_t bloom;  // Bit (hash % 64) is set for each name in the set
+};
+
+static HideSet *hide_set_add(HideSet *hide_set, Atom *name)
+{
+  HideSet *new = malloc(sizeof(HideSet));
+  new->name = name;
+  new->next = hide_set;
+  new->bloom = (hide_set ? hide_set->bloom : 0) | 1ULL << (name->hash % 64);
+  return new;
+}
+
+static bool hide_set_contains(HideSet *hide_set, Atom *name)
+{
+  if (!hide_set || !(hide_set->bloom & 1ULL << (name->hash % 64)))
+    return false;
+  for (; hide_set; hide_set = hide_set->next)
+    if (hide_set->name == name)
+      return true;
+  return false;
+}
+
+// Names of hide_set1 that are also in hide_set2
+static HideSet *hide_set_intersection(HideSet *hide_set1, HideSet *hide_set2)
+{
+  if (hide_set1 == hide_set2)
+    return hide_set1;
+  HideSet *result = NULL;
+  for (; hide_set1 && hide_set2; hide_set1 = hide_set1->next)
+    if (hide_set_contains(hide_set2, hide_set1->name))
+      result = hide_set_add(result, hide_set1->name);
+  return result;
+}
+
+static HideSet *hide_set_union(HideSet *hide_set1, HideSet *hide_set2)
+{
+  if (!hide_set1 || hide_set1 == hide_set2)
+    return hide_set2;
+  HideSet *result = hide_set2;
+  for (; hide_set1; hide_set1 = hide_set1->next)
+    if (!hide_set_contains(result, hide_set1->name))
+      result = hide_set_add(result, hide_set1->name);
+  return result;
+}
+
+int find_macro_name_without_hide_set(Token *identifier, HideSet *hide_set,
                                      Vector **argument_list,
-                                     Vector **token_string, Token **token,
-                                     size_t *location);
+                                     Vector **token_string, Token **token);
 
 // If the argument string is defined as an object-like macro, it returns 1.
 // If it is defined as a function-like macro, it returns 2. Otherwise, it
 // returns 0.
 inline int find_macro_name_all(Token *identifier)
 {
-  return find_macro_name_without_hide_set(identifier, NULL, NULL, NULL, NULL,
-                                          NULL);
+  return find_macro_name_without_hide_set(identifier, NULL, NULL, NULL, NULL);
 }
 
 // If the argument string is defined as an object-like macro, it returns 1.
 // If it is defined as a function-like macro, it returns 2. Otherwise, it
-// returns 0. If it returns 1 or 2, the token string is stored in token_string,
-// the macro name is stored in token, and the location of the macro in the
-// (object or function)_macro_list is stored in location. (if they are non-null)
+// returns 0. If it returns 1 or 2, the token string is stored in token_string
+// and the macro name is stored in token. (if they are non-null)
 // If it returns 2, the function argument list is stored in argument_list.
 // However, this excludes those that have already been expanded.
-int find_macro_name_without_hide_set(Token *identifier, Vector *hide_set,
+int find_macro_name_without_hide_set(Token *identifier, HideSet *hide_set,
                                      Vector **argument_list,
-                                     Vector **token_string, Token **token,
-                                     size_t *location)
+                                     Vector **token_string, Token **token)
 {
+  // Only identifiers can name a macro
+  if (!identifier->atom)
+    return 0;
+  macro_slot *slot = macro_table_lookup(identifier->atom);
+  if (!slot || !slot->macro)
+    return 0;
   // hide set
-  if (hide_set)
-    for (size_t j = 1; j <= vector_size(hide_set); j++)
-    {
-      Token *hide = vector_peek_at(hide_set, j);
-      if (hide->len == identifier->len &&
-          !strncmp(hide->str, identifier->str, hide->len))
-        return 0;
-    }
-  // object like macro
-  for (size_t i = 1; i <= vector_size(object_like_macro_list); i++)
-  {
-    object_like_macro_storage *tmp = vector_peek_at(object_like_macro_list, i);
-    if (tmp->identifier->len == identifier->len &&
-        !strncmp(tmp->identifier->str, identifier->str, tmp->identifier->len))
-    {
-      if (token_string)
-        *token_string = tmp->token_string;
-      if (token)
-        *token = tmp->identifier;
-      if (location)
-        *location = i;
-      return 1;
-    }
+  if (hide_set_contains(hide_set, identifier->atom))
+    return 0;
+  if (slot->kind == 1)
+  {  // object like macro
+    object_like_macro_storage *macro = slot->macro;
+    if (token_string)
+      *token_string = macro->token_string;
+    if (token)
+      *token = macro->identifier;
+    return 1;
   }
   // function like macro
-  for (size_t i = 1; i <= vector_size(function_like_macro_list); i++)
+  function_like_macro_storage *macro = slot->macro;
+  if (token_string)
+    *token_string = macro->token_string;
+  if (argument_list)
+    *argument_list = macro->arguments;
+  if (token)
+    *token = macro->identifier;
+  return 2;
+}
+
+static void compile_function_like_macro(function_like_macro_storage *macro);
+
+// Whether two replacement lists are identical, that is, they have the same
+// tokens with whitespace at the same places (the amount of whitespace and
+// leading or trailing whitespace does not matter)
+static bool token_string_equal(Vector *token_string1, Vector *token_string2)
+{
+  size_t i = 1, j = 1;
+  for (;;)
   {
-    function_like_macro_storage *tmp =
-        vector_peek_at(function_like_macro_list, i);
-    if (tmp->identifier->len == identifier->len &&
-        !strncmp(tmp->identifier->str, identifier->str, tmp->identifier->len))
+    bool space1 = false, space2 = false;
+    Token *token1 = NULL, *token2 = NULL;
+    for (; i <= vector_size(token_string1); i++)
+    {
+      token1 = vector_peek_at(token_string1, i);
+      if (token1->kind != TK_IGNORABLE && token1->kind != TK_ILB)
+        break;
+      space1 = true;
+      token1 = NULL;
+    }
+    for (; j <= vector_size(token_string2); j++)
     {
-      if (token_string)
-        *token_string = tmp->token_string;
-      if (argument_list)
-        *argument_list = tmp->arguments;
-      if (token)
-        *token = tmp->identifier;
-      if (location)
-        *location = i;
-      return 2;
+      token2 = vector_peek_at(token_string2, j);
+      if (token2->kind != TK_IGNORABLE && token2->kind != TK_ILB)
+        break;
+      space2 = true;
+      token2 = NULL;
     }
+    if (!token1 || !token2)
+      return token1 == token2;
+    if ((i > 1 && space1 != space2) || token1->kind != token2->kind ||
+        token1->len != token2->len ||
+        memcmp(token1->str, token2->str, token1->len))
+      return false;
+    i++;
+    j++;
   }
-  return 0;
+}
+
+// Whether two parameter lists of function-like macros are identical
+static bool arguments_equal(Vector *arguments1, Vector *arguments2)
+{
+  if (vector_size(arguments1) != vector_size(arguments2))
+    return false;
+  for (size_t i = 1; i <= vector_size(arguments1); i++)
+    if (((Token *)vector_peek_at(arguments1, i))->atom !=
+        ((Token *)vector_peek_at(arguments2, i))->atom)
+      return false;
+  return true;
 }
 
 void add_object_like_macro(Vector *token_list)
 {  // #define identifier token-string_opt
   Token *identifier = vector_shift(token_list);
-  Vector *token_list_before = NULL;
-  int result = find_macro_name_without_hide_set(identifier, NULL, NULL,
-                                                &token_list_before, NULL, NULL);
-  if (result == 2 ||
-      (result == 1 && !vector_compare(token_list, token_list_before)))
+  macro_table_lookup(identifier->atom);  // a predefined macro is redefined
+  macro_slot *slot = macro_table_insert(identifier->atom);
+  if (slot->macro &&
+      (slot->kind == 2 ||
+       !token_string_equal(
+           token_list,
+           ((object_like_macro_storage *)slot->macro)->token_string)))
     error_at(identifier->str, identifier->len,
-             "Identifier %s is already defined.");
+             "Identifier %.*s is already defined.", (int)identifier->len,
+             identifier->str);
   object_like_macro_storage *new = malloc(sizeof(object_like_macro_storage));
   new->identifier = identifier;
   new->token_string = token_list;
-  if (!object_like_macro_list)
-    object_like_macro_list = vector_new();
-  vector_push(object_like_macro_list, new);
+  slot->kind = 1;
+  slot->macro = new;
 }
 
 void add_function_like_macro(Vector *token_list)
 {  // #define identifier(identifier_opt, identifier_opt) token-stirng_opt
   Token *identifier = vector_shift(token_list);
-  Vector *token_list_before = NULL;
-  int result = find_macro_name_without_hide_set(identifier, NULL, NULL,
-                                                &token_list_before, NULL, NULL);
-  if (result == 1 ||
-      (result == 2 && !vector_compare(token_list, token_list_before)))
-    error_at(identifier->str, identifier->len,
-             "Identifier %s is already defined.");
-
   function_like_macro_storage *new =
       malloc(sizeof(function_like_macro_storage));
   new->identifier = identifier;
   new->arguments = vector_shift(token_list);
   new->token_string = token_list;
-  if (!function_like_macro_list)
-    function_like_macro_list = vector_new();
-  vector_push(function_like_macro_list, new);
+  compile_function_like_macro(new);
+
+  macro_table_lookup(identifier->atom);  // a predefined macro is redefined
+  macro_slot *slot = macro_table_insert(identifier->atom);
+  function_like_macro_storage *old = slot->macro;
+  if (old && (slot->kind == 1 ||
+              !arguments_equal(new->arguments, old->arguments) ||
+              !token_string_equal(new->token_string, old->token_string)))
+    error_at(identifier->str, identifier->len,
+             "Identifier %.*s is already defined.", (int)identifier->len,
+             identifier->str);
+  slot->kind = 2;
+  slot->macro = new;
+}
+
+static bool is_whitespace(Token *token)
+{
+  return token->kind == TK_IGNORABLE || token->kind == TK_ILB;
+}
+
+static bool is_punctuator(Token *token, char c)
+{
+  return token->kind == TK_RESERVED && token->len == 1 && token->str[0] == c;
+}
+
+// Returns the parameter number (1-based) of the identifier in the replacement
+// list of macro, 0 if it is not a parameter
+static size_t parameter_number(function_like_macro_storage *macro,
+                               Token *token)
+{
+  if (token->kind != TK_IDENT)
+    return 0;
+  if (macro->is_variadic && token->atom == atom_intern("__VA_ARGS__", 11))
+    return vector_size(macro->arguments);
+  for (size_t i = 1; i <= vector_size(macro->arguments); i++)
+    if (((Token *)vector_peek_at(macro->arguments, i))->atom == token->atom)
+      return i;
+  return 0;
+}
+
+static macro_op *push_macro_op(Vector *ops, macro_op_kind kind)
+{
+  macro_op *op = calloc(1, sizeof(macro_op));
+  op->kind = kind;
+  vector_push(ops, op);
+  return op;
+}
+
+// Compiles the replacement list of a function-like macro into macro->body,
+// so that the parameters, # , ## and __VA_OPT__ are resolved only once
+// instead of on every expansion
+static void compile_function_like_macro(function_like_macro_storage *macro)
+{
+  Token *last = vector_size(macro->arguments)
+                    ? vector_peek_at(macro->arguments,
+                                     vector_size(macro->arguments))
+                    : NULL;
+  macro->is_variadic = last && last->atom == atom_intern("...", 3);
+  Atom *va_opt = atom_intern("__VA_OPT__", 10);
+
+  Vector *ops = vector_new();
+  Vector *token_string = macro->token_string;
+  bool is_paste = false;
+  macro_op *va_opt_op = NULL;  // __VA_OPT__ being compiled
+  size_t va_opt_nest = 0;
+  for (size_t i = 1; i <= vector_size(token_string); i++)
+  {
+    Token *token = vector_peek_at(token_string, i);
+    if (token->kind == TK_ILB || (is_whitespace(token) && is_paste))
+      continue;
+    if (token->kind == TK_DIRECTIVE)
+    {
+      Token *next = i < vector_size(token_string)
+                        ? vector_peek_at(token_string, i + 1)
+                        : NULL;
+      if (next && next->kind == TK_DIRECTIVE)
+      {  // ##
+        i++;
+        while (vector_size(ops) &&
+               ((macro_op *)vector_peek(ops))->kind == MACRO_OP_TOKEN &&
+               is_whitespace(((macro_op *)vector_peek(ops))->token))
+          free(vector_pop(ops));
+        if (!vector_size(ops) || is_paste)
+          error_at(token->str, 2,
+                   "'##' cannot appear at either end of a macro expansion");
+        is_paste = true;
+        continue;
+      }
+      // #
+      while (i < vector_size(token_string) &&
+             is_whitespace(vector_peek_at(token_string, i + 1)))
+        i++;
+      size_t parameter =
+          i < vector_size(token_string)
+              ? parameter_number(macro, vector_peek_at(token_string, i + 1))
+              : 0;
+      if (!parameter)
+        error_at(token->str, token->len,
+                 "'#' is not followed by a macro parameter");
+      i++;
+      macro_op *op = push_macro_op(ops, MACRO_OP_STRINGIZE);
+      op->parameter = parameter;
+      op->is_paste = is_paste;
+      is_paste = false;
+      continue;
+    }
+    if (macro->is_variadic && token->atom == va_opt && !va_opt_op)
+    {  // __VA_OPT__ ( ... )
+      while (i < vector_size(token_string) &&
+             is_whitespace(vector_peek_at(token_string, i + 1)))
+        i++;
+      if (i == vector_size(token_string) ||
+          !is_punctuator(vector_peek_at(token_string, ++i), '('))
+        error_at(token->str, token->len, "'(' is missing after __VA_OPT__");
+      va_opt_op = push_macro_op(ops, MACRO_OP_VA_OPT);
+      va_opt_op->parameter = vector_size(macro->arguments);
+      va_opt_nest = 1;
+      continue;
+    }
+    if (va_opt_op && token->kind == TK_RESERVED && token->len == 1)
+    {
+      if (token->str[0] == '(')
+        va_opt_nest++;
+      else if (token->str[0] == ')' && !--va_opt_nest)
+      {  // end of __VA_OPT__
+        va_opt_op->skip = vector_size(ops) - vector_search(ops, va_opt_op);
+        va_opt_op = NULL;
+        continue;
+      }
+    }
+
+    size_t parameter = parameter_number(macro, token);
+    macro_op *op;
+    if (parameter && is_paste && macro->is_variadic &&
+        parameter == vector_size(macro->arguments) &&
+        ((macro_op *)vector_peek(ops))->kind == MACRO_OP_TOKEN &&
+        is_punctuator(((macro_op *)vector_peek(ops))->token, ','))
+    {  // , ## __VA_ARGS__ (GNU extension)
+      op = push_macro_op(ops, MACRO_OP_VA_COMMA);
+      op->parameter = parameter;
+      is_paste = false;
+      continue;
+    }
+    if (parameter)
+    {
+      op = push_macro_op(ops, MACRO_OP_ARGUMENT);
+      op->parameter = parameter;
+    }
+    else
+    {
+      op = push_macro_op(ops, MACRO_OP_TOKEN);
+      op->token = token;
+    }
+    op->is_paste = is_paste;
+    is_paste = false;
+  }
+  if (is_paste)
+  {
+    Token *token = vector_peek(token_string);
+    error_at(token->str, token->len,
+             "'##' cannot appear at either end of a macro expansion");
+  }
+  if (va_opt_op)
+    error_at(macro->identifier->str, macro->identifier->len,
+             "Unterminated __VA_OPT__");
+
+  macro->body_len = vector_size(ops);
+  macro->body = malloc(macro->body_len * sizeof(macro_op));
+  for (size_t i = 1; i <= macro->body_len; i++)
+  {
+    macro_op *op = vector_peek_at(ops, i);
+    macro->body[i - 1] = *op;
+    free(op);
+  }
+  vector_free(ops);
+}
+
+// Length of the spelling of token (string and character literals are
+// stored without the quotes)
+static size_t token_spelling_len(Token *token)
+{
+  if (token->kind == TK_STRING || token->kind == TK_CHAR)
+    return token->len + 2;
+  return token->len;
+}
+
+// Writes the spelling of token to buf and returns the end
+static char *token_spelling(Token *token, char *buf)
+{
+  if (token->kind == TK_STRING || token->kind == TK_CHAR)
+  {
+    char quote = token->kind == TK_STRING ? '"' : '\'';
+    *buf++ = quote;
+    memcpy(buf, token->str, token->len);
+    buf += token->len;
+    *buf++ = quote;
+    return buf;
+  }
+  memcpy(buf, token->str, token->len);
+  return buf + token->len;
+}
+
+// # operator: makes a string literal of the spelling of argument.
+// Whitespace between tokens becomes one space, and '"' and '\' in string
+// and character literals are escaped.
+static Token *stringize(Vector *argument)
+{
+  size_t len = 0;
+  for (size_t i = 1; i <= vector_size(argument); i++)
+  {
+    Token *token = vector_peek_at(argument, i);
+    if (is_whitespace(token))
+      len++;
+    else
+      len += token_spelling_len(token) * 2;  // enough for the escapes
+  }
+  char *str = malloc(len + 1);
+  char *p = str;
+  bool is_space = false;
+  for (size_t i = 1; i <= vector_size(argument); i++)
+  {
+    Token *token = vector_peek_at(argument, i);
+    if (is_whitespace(token))
+    {
+      is_space = p != str;
+      continue;
+    }
+    if (is_space)
+      *p++ = ' ';
+    is_space = false;
+    if (token->kind != TK_STRING && token->kind != TK_CHAR)
+    {
+      p = token_spelling(token, p);
+      continue;
+    }
+    char *spelling = malloc(token_spelling_len(token));
+    char *end = token_spelling(token, spelling);
+    for (char *c = spelling; c != end; c++)
+    {
+      if (*c == '"' || *c == '\\')
+        *p++ = '\\';
+      *p++ = *c;
+    }
+    free(spelling);
+  }
+  Token *result = token_alloc();
+  result->kind = TK_STRING;
+  result->str = str;
+  result->len = p - str;
+  return result;
+}
+
+// ## operator: replaces the tokens at index and index + 1 in result with the
+// tokens made from their concatenated spelling
+static void paste(Vector *result, size_t index)
+{
+  Token *lhs = vector_peek_at(result, index);
+  Token *rhs = vector_peek_at(result, index + 1);
+  size_t len = token_spelling_len(lhs) + token_spelling_len(rhs);
+  char *str = malloc(len + 1);
+  char *end = token_spelling(rhs, token_spelling(lhs, str));
+  *end = '\0';
+  vector_pop_at(result, index + 1);
+  vector_pop_at(result, index);
+  for (char *p = str; p != end;)
+  {
+    Token *token = tokenize_once(p, &p);
+    vector_insert(result, index++, token);
+  }
+}
+
+// Whether argument has a token other than whitespace
+static bool has_tokens(Vector *argument)
+{
+  for (size_t i = 1; i <= vector_size(argument); i++)
+    if (!is_whitespace(vector_peek_at(argument, i)))
+      return true;
+  return false;
+}
+
+// Links the tokens of result between token and next and adds hide_set to
+// their hide sets. The caller rescans them together with the tokens after
+// next.
+static void insert_expansion(Token *token, Vector *result, HideSet *hide_set,
+                             Token *next)
+{
+  // The tokens of an argument mostly share their hide set
+  HideSet *last = NULL;
+  HideSet *last_union = hide_set;
+  for (size_t i = 1; i <= vector_size(result); i++)
+  {
+    Token *replaced = vector_peek_at(result, i);
+    HideSet *replaced_hide_set = token_hide_set(replaced);
+    if (replaced_hide_set != last)
+    {
+      last = replaced_hide_set;
+      last_union = hide_set_union(last, hide_set);
+    }
+    token_set_hide_set(replaced, last_union);
+    if (replaced->kind == TK_DIRECTIVE)  // '#' in an expansion is no directive
+      replaced->kind = TK_RESERVED;
+    if (replaced->kind == TK_ILB)  // the line has already been counted
+      replaced->kind = TK_IGNORABLE;
+    token = token->next = replaced;
+  }
+  token->next = next;
+}
+
+// Fully expands the macros of argument on its own, as an argument is before
+// it is substituted (C11 6.10.3.1), and returns the resulting tokens
+static Vector *expand_argument(Vector *argument)
+{
+  Token *head = token_alloc();
+  Token *tail = head;
+  for (size_t i = 1; i <= vector_size(argument); i++)
+  {
+    tail = tail->next = token_copy(vector_peek_at(argument, i));
+    if (tail->kind == TK_ILB)  // the line has already been counted
+      tail->kind = TK_IGNORABLE;
+  }
+  Token *end = token_alloc();
+  end->kind = TK_EOF;
+  tail->next = end;
+
+  for (Token *token = head->next; token != end; token = token->next)
+  {
+    Token *last = ident_replacement(token);
+    if (last)
+      token = last;
+  }
+  Vector *result = vector_new();
+  for (Token *token = head->next; token != end; token = token->next)
+    if (token->kind != TK_IGNORABLE || token->str)  // skip the voided tokens
+      vector_push(result, token);
+  return result;
+}
+
+// Replaces the invocation of the function-like macro at token with its
+// expansion, which follows the returned token
+static Token *expand_function_like_macro(Token *token,
+                                         function_like_macro_storage *macro)
+{
+  Atom *name = token->atom;
+  char *name_str = token->str;
+  size_t name_len = token->len;
+  HideSet *hide_set = token_hide_set(token);
+  token_void(token);
+  Token *const old = token;  // points to the token to be replaced (void)
+  Token *next = token_next_not_ignorable_void(token);  // '('
+  token_void(next);
+
+  // Collect the arguments. The variable arguments are kept as one argument
+  // including the commas. Leading and trailing whitespace is removed.
+  size_t parameters = vector_size(macro->arguments);
+  Vector *arguments = vector_new();
+  Vector *argument = vector_new();
+  vector_push(arguments, argument);
+  size_t nest_counter = 0;
+  for (;;)
+  {
+    next = token_next_lazy(next);
+    switch (next->kind)
+    {
+      case TK_EOF:
+        error_at(name_str, name_len, "Unterminated macro invocation.");
+        break;
+      case TK_LINEBREAK:
+        line_count();
+        token_void(next);
+        break;
+      case TK_ILB: line_count(); break;
+      default: break;
+    }
+    if (next->kind == TK_RESERVED && next->len == 1)
+    {
+      if (next->str[0] == '(')
+        nest_counter++;
+      else if (next->str[0] == ')' && nest_counter)
+        nest_counter--;
+      else if (next->str[0] == ')')
+      {
+        token_void(next);
+        break;
+      }
+      else if (next->str[0] == ',' && !nest_counter &&
+               (!macro->is_variadic || vector_size(arguments) < parameters))
+      {
+        token_void(next);
+        argument = vector_new();
+        vector_push(arguments, argument);
+        continue;
+      }
+    }
+    if (is_whitespace(next) && !vector_size(argument))
+      continue;
+    vector_push(argument, next);
+  }
+  for (size_t i = 1; i <= vector_size(arguments); i++)
+  {
+    argument = vector_peek_at(arguments, i);
+    while (vector_size(argument) && is_whitespace(vector_peek(argument)))
+      vector_pop(argument);
+  }
+  // The variable arguments may be left out, and a macro without parameters
+  // takes a single empty argument
+  size_t count = vector_size(arguments);
+  bool is_valid_count = count == parameters;
+  if (macro->is_variadic)
+    is_valid_count = count + 1 >= parameters;
+  else if (!parameters)
+    is_valid_count = !vector_size(vector_peek_at(arguments, 1));
+  if (!is_valid_count)
+    error_at(name_str, name_len,
+             "Macro %s takes %zu arguments, but %zu were given.", name->str,
+             parameters - macro->is_variadic, count);
+
+  // Run the compiled replacement list. The arguments are expanded when they
+  // are first substituted, except for the operands of # and ##.
+  Vector *expanded = vector_new();
+  for (size_t i = 1; i <= vector_size(arguments); i++)
+    vector_push(expanded, NULL);
+  Vector *result = vector_new();
+  bool placemarker = false;  // the last operand was an empty argument
+  for (size_t i = 0; i < macro->body_len; i++)
+  {
+    macro_op *op = &macro->body[i];
+    size_t paste_location = vector_size(result);
+    argument = op->parameter && op->parameter <= vector_size(arguments)
+                   ? vector_peek_at(arguments, op->parameter)
+                   : NULL;
+    switch (op->kind)
+    {
+      case MACRO_OP_TOKEN: vector_push(result, token_copy(op->token)); break;
+      case MACRO_OP_ARGUMENT:
+        if (argument && !op->is_paste &&
+            !(i + 1 < macro->body_len && macro->body[i + 1].is_paste))
+        {
+          if (!vector_peek_at(expanded, op->parameter))
+            vector_replace_at(expanded, op->parameter,
+                              expand_argument(argument));
+          argument = vector_peek_at(expanded, op->parameter);
+        }
+        for (size_t j = 1; argument && j <= vector_size(argument); j++)
+          vector_push(result, token_copy(vector_peek_at(argument, j)));
+        break;
+      case MACRO_OP_STRINGIZE:
+        vector_push(result, stringize(argument ? argument : vector_new()));
+        break;
+      case MACRO_OP_VA_COMMA:
+        if (argument && has_tokens(argument))
+          for (size_t j = 1; j <= vector_size(argument); j++)
+            vector_push(result, token_copy(vector_peek_at(argument, j)));
+        else
+          vector_pop(result);  // the comma
+        break;
+      case MACRO_OP_VA_OPT:
+        if (!argument || !has_tokens(argument))
+          i += op->skip;
+        break;
+      default: unreachable();
+    }
+    // An empty argument is a placemarker, which ## leaves the other operand
+    // alone with (C11 6.10.3.3)
+    if (op->is_paste && paste_location && !placemarker &&
+        vector_size(result) > paste_location)
+      paste(result, paste_location);
+    placemarker = op->kind == MACRO_OP_ARGUMENT &&
+                  vector_size(result) == paste_location &&
+                  (!op->is_paste || placemarker);
+  }
+
+  // HS(name) & HS(')') | {name}, as ')' may come after the expansion that
+  // made name
+  insert_expansion(
+      old, result,
+      hide_set_add(hide_set_intersection(hide_set, token_hide_set(next)), name),
+      next);
+  vector_free(result);
+  for (size_t i = 1; i <= vector_size(arguments); i++)
+  {
+    vector_free(vector_peek_at(arguments, i));
+    if (vector_peek_at(expanded, i))
+      vector_free(vector_peek_at(expanded, i));
+  }
+  vector_free(arguments);
+  vector_free(expanded);
+  return old;
 }
 
 extern char *File_Name;
 extern size_t File_Line;
 extern long long include_level;
 
-bool ident_replacement_recursive(Token *token, Vector *hide_set)
+// function to expand #define
+// Returns NULL if token is not a macro. Otherwise, the caller continues after
+// the returned token, where the expansion is linked, so that it is rescanned
+// with the rest of the tokens.
+Token *ident_replacement(Token *token)
 {
   if (token->kind != TK_STRING && token->len == 8)
   {
@@ -147,9 +860,10 @@ bool ident_replacement_recursive(Token *token, Vector *hide_set)
       char *file_name = malloc(file_name_len);  // no need for NULL terminator
       strncpy(file_name, File_Name, file_name_len);
       token->kind = TK_STRING;
-      token->len = file_name_len + 2;
+      token->len = file_name_len;  // the token excludes the quotes
       token->str = file_name;
-      return true;
+      token->atom = NULL;
+      return token;
     }
     if (!strncmp(token->str, "__LINE__", 8))
     {
@@ -166,7 +880,8 @@ bool ident_replacement_recursive(Token *token, Vector *hide_set)
       }
       token->len = file_line_len;
       token->str = file_line_str;
-      return true;
+      token->atom = atom_intern(file_line_str, file_line_len);
+      return token;
     }
     int is_date = !strncmp(token->str, "__DATE__", 8);
     int is_time = !strncmp(token->str, "__TIME__", 8);
@@ -177,24 +892,24 @@ bool ident_replacement_recursive(Token *token, Vector *hide_set)
         error_exit("Failed to get time.");
       // asctime
       char *asctime_str = asctime(localtime(&current_time));
-      char *time_str;
+      char *time_str;  // the token excludes the quotes
       if (is_date)
       {
-        time_str = malloc(13 * sizeof(char));
-        memcpy(time_str + 1, asctime_str + 4, 7);
-        memcpy(time_str + 8, asctime_str + 20, 4);
-        token->len = 13;
+        time_str = malloc(11 * sizeof(char));
+        memcpy(time_str, asctime_str + 4, 7);
+        memcpy(time_str + 7, asctime_str + 20, 4);
+        token->len = 11;
       }
       if (is_time)
       {
-        time_str = malloc(10 * sizeof(char));
-        memcpy(time_str + 1, asctime_str + 11, 8);
-        token->len = 10;
+        time_str = malloc(8 * sizeof(char));
+        memcpy(time_str, asctime_str + 11, 8);
+        token->len = 8;
       }
       token->kind = TK_STRING;
-      time_str[0] = time_str[token->len - 1] = '"';
       token->str = time_str;
-      return true;
+      token->atom = NULL;
+      return token;
     }
   }
   if (token->len == 17)
@@ -212,317 +927,45 @@ bool ident_replacement_recursive(Token *token, Vector *hide_set)
         if (file_line_len < 0 || file_line_len + 1 > size)
           error_exit("Failed to preprocess __INCLUDE_LEVEL__.");
       }
-      token->kind = TK_STRING;
       token->len = file_line_len;
       token->str = file_line_str;
-      return true;
+      token->atom = atom_intern(file_line_str, file_line_len);
+      return token;
     }
   }
 
   Vector *token_string = NULL;
-  Token *token_identifier;
-  Vector *argument_list = NULL;
+  HideSet *identifier_hide_set = token_hide_set(token);
   size_t is_defined = find_macro_name_without_hide_set(
-      token, hide_set, &argument_list, &token_string, &token_identifier, NULL);
+      token, identifier_hide_set, NULL, &token_string, NULL);
   if (is_defined == 1)
   {  // if it is an object-like macro
-    vector_push(hide_set, token_identifier);
-    Token *tmp = token;
-    Token *old = token;
-    Token *next = token->next;
-    if (token_string && vector_size(token_string))
-    {
-      for (size_t i = 1; i <= vector_size(token_string); i++)
-      {
-        Token *replace_token = vector_peek_at(token_string, i);
-        memcpy(tmp, replace_token, sizeof(Token));
-        tmp->next = malloc(sizeof(Token));
-        old = tmp;
-        tmp = tmp->next;
-      }
-      old->next = next;
-      while (token != next)
-      {
-        ident_replacement_recursive(token, hide_set);
-        token = token->next;
-      }
-      return true;
-    }
+    Vector *result = vector_new();
+    for (size_t i = 1; token_string && i <= vector_size(token_string); i++)
+      vector_push(result, token_copy(vector_peek_at(token_string, i)));
+    HideSet *hide_set = hide_set_add(identifier_hide_set, token->atom);
     token_void(token);
-    return true;
+    insert_expansion(token, result, hide_set, token->next);
+    vector_free(result);
+    return token;
   }
   else if (is_defined == 2 &&
            token_next_not_ignorable(token)->kind == TK_RESERVED &&
            token_next_not_ignorable(token)->str[0] == '(')
   {  // if it is a function-like macro
-    token_void(token);
-    // Vector containing the actual argument list of the function-like macro
-    Vector *argument_real_list = vector_new();
-    vector_push(hide_set, token_identifier);
-    Token *const old = token;  // points to the token to be replaced (void)
-    Token *next = token_next_not_ignorable_void(token);
-    token_void(next);
-    next = token_next_not_ignorable_void(next);
-    bool is_end = false;  // whether it is immediately after an IDENT
-    size_t nest_counter = 0;
-    // put the function arguments into a vector
-    for (;;)
-    {
-      if (!is_end)
-      {
-        Vector *list = vector_new();
-        vector_push(argument_real_list, list);
-        while (nest_counter || next->kind != TK_RESERVED || next->len != 1 ||
-               (next->str[0] != ',' && next->str[0] != ')'))
-        {
-          if (next->kind == TK_LINEBREAK)
-          {
-            line_count();
-            token_void(next);
-          }
-          if (next->kind == TK_RESERVED && next->len == 1 &&
-              next->str[0] == '(')
-            nest_counter++;
-          if (next->kind == TK_RESERVED && next->len == 1 &&
-              next->str[0] == ')')
-            nest_counter--;
-          vector_push(list, next);
-          next = token_next_not_ignorable(next);
-        }
-        is_end = true;
-        continue;
-      }
-      if (is_end && next->kind == TK_RESERVED)
-      {
-        if (next->str[0] == ',')
-        {
-          next = next->next;
-          is_end = false;
-          continue;
-        }
-        if (next->str[0] == ')')
-        {
-          token_void(next);
-          break;
-        }
-      }
-      error_at(next->str, next->len, "Invalid #define directive.");
-    }
-    if (token_string && vector_size(token_string))
-    {  // perform replacement for function-like macro
-
-      // save the replaced data of the function-like macro
-      Vector *result = vector_new();
-
-      size_t directive_count = 0;
-      for (size_t i = 1; i <= vector_size(token_string); i++)
-      {
-        Token *replace_token = vector_peek_at(token_string, i);
-        bool is_args = false;
-        bool is_ops = false;
-        switch (replace_token->kind)
-        {
-          case TK_DIRECTIVE: directive_count++; continue;
-          case TK_ILB: token_void(replace_token); continue;
-          case TK_LINEBREAK: unreachable();
-          default: break;
-        }
-
-        if (replace_token->len == 10 &&
-            !strncmp(replace_token->str, "__VA_OPS__", 10))
-          is_ops = true;
-        else if (replace_token->len == 11 &&
-                 !strncmp(replace_token->str, "__VA_ARGS__", 11))
-        {
-          switch (directive_count)
-          {
-            case 0: is_args = true; break;
-            case 2:
-            {
-              is_ops = true;
-              directive_count = 0;
-              break;
-            }
-            default: unreachable();
-          }
-        }
-
-        if (is_args || is_ops)
-        {  // replace __VA_ARGS__, etc.
-          // check that the last argument of the macro is "..."
-          Token *last =
-              vector_peek_at(argument_list, vector_size(argument_list));
-          if (last->len != 3 || strncmp(last->str, "...", 3) ||
-              (is_ops ? vector_size(argument_list) - 1 >
-                            vector_size(argument_real_list)
-                      : vector_size(argument_list) - 1 >=
-                            vector_size(argument_real_list)))
-            error_at(token->str, token->len,
-                     "Invalid function-like macro argument.");
-          if (is_ops &&
-              vector_size(argument_list) - 1 ==
-                  vector_size(argument_real_list) &&
-              vector_size(result) >= 2)
-          {
-            Token *old_str = vector_peek_at(result, vector_size(result) - 1);
-            size_t old_str_location = 1;
-            while (old_str->kind == TK_IGNORABLE)
-            {
-              old_str = vector_peek_at(
-                  result, vector_size(result) - ++old_str_location);
-            }
-            if (old_str->kind == TK_RESERVED && old_str->len == 1 &&
-                old_str->str[0] == ',')
-              vector_pop_at(result, vector_size(result) - old_str_location);
-          }
-          else
-          {
-            // start is the beginning of __VA_ARGS__
-            Token *ptr = vector_peek_at(
-                vector_peek_at(argument_real_list, vector_size(argument_list)),
-                1);
-            while (ptr != next)
-            {  // next is the end of __VA_ARGS__
-              vector_push(result, ptr);
-              ptr = ptr->next;
-            }
-          }
-        }
-        else
-        {
-          bool is_argument = false;
-          if (replace_token->kind == TK_IDENT ||
-              replace_token->kind == TK_STRING ||
-              replace_token->kind == TK_RESERVED)
-          {  // perform normal replacement (other than __VA_ARGS__, etc.)
-            for (size_t j = 1; j <= vector_size(argument_list); j++)
-            {  // search for something that matches the macro argument
-              Token *argument = vector_peek_at(argument_list, j);
-              if (argument->len == replace_token->len &&
-                  !strncmp(argument->str, replace_token->str, argument->len))
-              {  // if it matches the macro argument
-                size_t start = vector_size(result) + 1;
-                for (size_t k = 1;
-                     k <= vector_size(vector_peek_at(argument_real_list, j));
-                     k++)
-                {  // copy the actual argument corresponding to the macro
-                   // argument
-                  vector_push(
-                      result,
-                      vector_peek_at(vector_peek_at(argument_real_list, j), k));
-                }
-                is_argument = true;
-                if (directive_count == 1)
-                {  // stringizing
-                  size_t stringizing_len_count = 0;
-                  for (size_t k = start; k <= vector_size(result); k++)
-                    stringizing_len_count +=
-                        ((Token *)vector_peek_at(result, k))->len;
-
-                  char *stringizing = malloc(stringizing_len_count + 2);
-                  stringizing[0] = stringizing[stringizing_len_count + 1] = '"';
-                  size_t stringizing_ptr = 1;
-                  for (size_t k = start; k <= vector_size(result); k++)
-                  {
-                    Token *tmp = ((Token *)vector_pop_at(result, k));
-                    strncpy(stringizing + stringizing_ptr, tmp->str, tmp->len);
-                    stringizing_ptr += tmp->len;
-                  }
-                  Token *tmp = calloc(1, sizeof(Token));
-                  tmp->kind = TK_STRING;
-                  tmp->str = stringizing;
-                  tmp->len = stringizing_len_count + 2;
-                  vector_push(result, tmp);
-                  directive_count = 0;
-                }
-                break;
-              }
-            }
-          }
-          if (!is_argument)
-          {
-            Token *tmp = malloc(sizeof(Token));
-            memcpy(tmp, vector_peek_at(token_string, i), sizeof(Token));
-            vector_push(result, tmp);
-          }
-        }
-        if (replace_token->kind == TK_IDENT ||
-            replace_token->kind == TK_STRING ||
-            replace_token->kind == TK_RESERVED)
-        {
-          switch (directive_count)
-          {
-            case 0: break;
-            case 2:
-            {  // concatenation
-              size_t vector_len = vector_size(result);
-              Token *concatenation_last = vector_pop_at(result, vector_len);
-              size_t concatenation_size = concatenation_last->len;
-              size_t token_concatenation_start_location = 1;
-              Token *tmp = vector_pop_at(result, vector_len - 1);
-              while (tmp->kind == TK_IGNORABLE)
-              {
-                tmp = vector_pop_at(
-                    result, vector_len - ++token_concatenation_start_location);
-              }
-              concatenation_size += tmp->len;
-              char *concatenation_str = malloc(concatenation_size);
-              strncpy(concatenation_str, tmp->str, tmp->len);
-              strncpy(concatenation_str + tmp->len, concatenation_last->str,
-                      concatenation_last->len);
-              char *end = NULL;
-              do
-              {
-                Token *concatenation_token =
-                    tokenize_once(concatenation_str, &end);
-                vector_push(result, concatenation_token);
-              } while (end < concatenation_str + concatenation_size);
-              directive_count = 0;
-            }
-            break;
-            default: unreachable();
-          }
-        }
-      }
-      Token *ptr = old;
-      for (size_t i = 1; i <= vector_size(result); i++)
-      {
-        Token *tmp = vector_peek_at(result, i);
-        ptr = ptr->next = tmp;
-      }
-      ptr->next = next;
-      for (size_t i = 1; i <= vector_size(result); i++)
-        ident_replacement_recursive(vector_peek_at(result, i), hide_set);
-      vector_free(result);
-      return true;
-    }
-    token_void(token);
-    return true;
+    return expand_function_like_macro(token,
+                                      macro_table_find(token->atom)->macro);
   }
-  return false;
-}
-
-// function to expand #define
-// return value is the token at the end of the expansion
-bool ident_replacement(Token *token)
-{
-  // expand what is defined by #define
-  Vector *hide_set = vector_new();
-  bool tmp = ident_replacement_recursive(token, hide_set);
-  vector_free(hide_set);
-  return tmp;
+  return NULL;
 }
 
 void undef_macro(Token *token)
 {
-  size_t location;
-  int result = find_macro_name_without_hide_set(token, NULL, NULL, NULL, NULL,
-                                                &location);
-  switch (result)
-  {
-    case 0: break;
-    case 1: vector_pop_at(object_like_macro_list, location); break;
-    case 2: vector_pop_at(function_like_macro_list, location); break;
-    default: unreachable(); break;
-  }
-}
\ No newline at end of file
+  if (!token->atom)
+    return;
+  macro_slot *slot = macro_table_lookup(token->atom);
+  if (!slot)
+    return;
+  slot->kind = 0;
+  slot->macro = NULL;
+}
@@ -0,0 +1,93 @@
+// ------------------------------------------------------------------------------------
+// dependency output (-MD)
+// ------------------------------------------------------------------------------------
+
+#include "include/dependency.h"
+
+#ifdef SELF_HOST
+#include "test/compiler_header.h"
+#else
+#include <stdlib.h>
+#include <string.h>
+#endif
+
+#include "include/output.h"
+#include "include/vector.h"
+
+// Headers read by #include, in the order they were first included
+typedef struct
+{
+  char *path;  // Path as resolved when it was first included
+  bool is_system;
+} dependency;
+
+static Vector *dependencies;
+
+// Records that the header at path is included. Each file is recorded once,
+// however it is spelled.
+void dependency_add(Header *header, char *path, bool is_system)
+{
+  if (header->is_dependency)
+    return;
+  header->is_dependency = true;
+  if (!dependencies)
+    dependencies = vector_new();
+  dependency *new = malloc(sizeof(dependency));
+  new->path = path;
+  new->is_system = is_system;
+  vector_push(dependencies, new);
+}
+
+// Writes path escaped for make
+static void write_path(char *path)
+{
+  for (; *path; path++)
+  {
+    if (*path == ' ' || *path == '#')
+      output_char('\\');
+    else if (*path == '$')
+      output_char('$');
+    output_char(*path);
+  }
+}
+
+// Writes a makefile rule "target: input headers..." to filename.
+// target is escaped like the paths if quote_target is true.
+// has_system false leaves out the headers found in the system include paths
+// (-MMD). is_phony adds an empty rule for each header (-MP), so that make
+// does not fail when a header is removed.
+void dependency_write(char *filename, char *target, bool quote_target,
+                      char *input_file_name, bool is_phony, bool has_system)
+{
+  output_open(filename);
+  if (quote_target)
+    write_path(target);
+  else
+    output_string(target);
+  output_char(':');
+  if (input_file_name && strcmp(input_file_name, "-"))
+  {
+    output_char(' ');
+    write_path(input_file_name);
+  }
+  size_t count = dependencies ? vector_size(dependencies) : 0;
+  for (size_t i = 1; i <= count; i++)
+  {
+    dependency *header = vector_peek_at(dependencies, i);
+    if (!has_system && header->is_system)
+      continue;
+    output_string(" \\\n ");
+    write_path(header->path);
+  }
+  output_char('\n');
+  for (size_t i = 1; is_phony && i <= count; i++)
+  {
+    dependency *header = vector_peek_at(dependencies, i);
+    if (!has_system && header->is_system)
+      continue;
+    output_char('\n');
+    write_path(header->path);
+    output_string(":\n");
+  }
+  output_close();
+}
@@ -11,39 +11,88 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 #include "include/error.h"
 
-char *file_read(FILE *fin)
+// Map a regular file into memory without copying it.
+// The mapping is placed at the head of an anonymous (zero-filled) region one
+// page longer than the file, so the bytes following the end of the file are
+// always readable and '\0'. Only the page holding the last byte is copied when
+// the missing trailing '\n' has to be written.
+static char *file_map(int fd, size_t filesize)
+{
+  size_t page_size = getpagesize();
+  size_t map_size = (filesize + page_size - 1) / page_size * page_size;
+  char *buf = mmap(NULL, map_size + page_size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (buf == MAP_FAILED)
+    return NULL;
+  if (mmap(buf, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd,
+           0) == MAP_FAILED)
+  {
+    munmap(buf, map_size + page_size);
+    return NULL;
+  }
+  if (buf[filesize - 1] != '\n')  // make sure the file ends with "\n\0"
+    buf[filesize] = '\n';
+  return buf;
+}
+
+// Read a stream whose size is unknown in advance (pipes, terminals).
+static char *file_read_stream(FILE *fin)
 {
-  // verify file size
-  if (fseek(fin, 0, SEEK_END) == -1)
-    error_exit("failed to seek file pointer to end-of-file: %s",
-               strerror(errno));
-  long filesize = ftell(fin);
-  if (filesize == -1)
-    error_exit("failed to read file pointer location: %s", strerror(errno));
-
-  if (fseek(fin, 0, SEEK_SET) == -1)
-    error_exit("failed to seek file pointer to start-of-file: %s",
-               strerror(errno));
-  pr_debug("file size: %ld", filesize);
-
-  char *buf = calloc(1, filesize + 2);
-  fread(buf, filesize, 1, fin);
+  size_t capacity = 4096;
+  size_t filesize = 0;
+  char *buf = malloc(capacity);
+  for (;;)
+  {
+    if (capacity - filesize < 3)  // keep room for "\n\0"
+      buf = realloc(buf, capacity *= 2);
+    size_t read_size = fread(buf + filesize, 1, capacity - filesize - 2, fin);
+    filesize += read_size;
+    if (read_size)
+      continue;
+    if (ferror(fin))
+      error_exit("failed to read file: %s", strerror(errno));
+    break;
+  }
   if (filesize == 0 ||
       buf[filesize - 1] != '\n')  // make sure the file ends with "\n\0"
     buf[filesize++] = '\n';       // rewrite if the last is EOF
   buf[filesize] = '\0';
+  return buf;
+}
+
+// Load the whole file and return it terminated with "\n\0".
+// Regular files are memory-mapped, other streams are read into a buffer.
+// fin is closed.
+char *file_read(FILE *fin)
+{
+  struct stat file_stat;
+  if (fstat(fileno(fin), &file_stat) == -1)
+    error_exit("failed to get file status: %s", strerror(errno));
+
+  char *buf = NULL;
+  if (S_ISREG(file_stat.st_mode) && file_stat.st_size > 0)
+    buf = file_map(fileno(fin), file_stat.st_size);
+  if (!buf)
+    buf = file_read_stream(fin);
+  pr_debug("file size: %ld", file_stat.st_size);
+  fclose(fin);
   pr_debug2("file content:\n%s", buf);
   return buf;
 }
 
 // Read the file with the argument file name and return it as a char array.
-// Internally uses calloc
+// "-" reads the standard input.
 char *openfile(char *filename)
 {
+  if (!strcmp(filename, "-"))
+    return file_read(stdin);
   FILE *fin = fopen(filename, "r");
   if (!fin)
   {
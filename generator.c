@@ -19,16 +19,129 @@
 #include "include/ir_generator.h"
 #include "include/vector.h"
 
-FILE *fout;
+// Source length of the character at str of a string literal ending at end
+static size_t literal_char_len(char *str, char *end)
+{
+  char *p = str + 1;
+  if (*str != '\\' || p == end)
+    return 1;
+  if (*p == 'x')
+    for (p++; p < end && (('0' <= *p && *p <= '9') || ('a' <= *p && *p <= 'f') ||
+                          ('A' <= *p && *p <= 'F'));
+         p++)
+      ;
+  else if ('0' <= *p && *p <= '7')
+    for (size_t i = 0; i < 3 && p < end && '0' <= *p && *p <= '7'; i++)
+      p++;
+  else
+    p++;
+  return p - str;
+}
+
+// Compare the spellings of two string literals from their last characters
+static int compare_reversed(Var *a, Var *b)
+{
+  char *end_a = a->token->str + a->token->len;
+  char *end_b = b->token->str + b->token->len;
+  size_t len = a->token->len < b->token->len ? a->token->len : b->token->len;
+  for (size_t i = 1; i <= len; i++)
+    if (end_a[-i] != end_b[-i])
+      return (unsigned char)end_a[-i] - (unsigned char)end_b[-i];
+  return a->token->len < b->token->len ? -1 : a->token->len > b->token->len;
+}
+
+// Merge sort the string literals by compare_reversed()
+static void sort_reversed(Var **strings, Var **work, size_t len)
+{
+  if (len < 2)
+    return;
+  size_t half = len / 2;
+  sort_reversed(strings, work, half);
+  sort_reversed(strings + half, work, len - half);
+  size_t i = 0, j = half, k = 0;
+  while (i < half && j < len)
+    work[k++] = compare_reversed(strings[j], strings[i]) < 0 ? strings[j++]
+                                                             : strings[i++];
+  while (i < half)
+    work[k++] = strings[i++];
+  while (j < len)
+    work[k++] = strings[j++];
+  memcpy(strings, work, len * sizeof(Var *));
+}
+
+// If the last suffix_len characters of the spelling of container start a
+// character, store the number of bytes before them in offset
+static bool literal_offset(Token *container, size_t suffix_len, size_t *offset)
+{
+  char *end = container->str + container->len;
+  char *suffix = end - suffix_len;
+  char *p = container->str;
+  *offset = 0;
+  for (; p < suffix; (*offset)++)
+    p += literal_char_len(p, end);
+  return p == suffix;
+}
+
+// Write the string literals. A literal that is the tail of another one is
+// emitted as an offset into it: sorted by their reversed spellings, the
+// literals whose spellings end with the spelling of a literal follow it. The
+// first of them where the tail starts a character, rather than the middle of
+// an escape sequence, is taken.
+static void generate_strings(Vector *string_list)
+{
+  size_t len = vector_size(string_list);
+  Var **strings = malloc(len * sizeof(Var *));
+  Var **work = malloc(len * sizeof(Var *));
+  for (size_t i = 0; i < len; i++)
+    strings[i] = vector_peek_at(string_list, i + 1);
+  sort_reversed(strings, work, len);
+
+  Var **container = calloc(len, sizeof(Var *));
+  size_t *offset = calloc(len, sizeof(size_t));
+  for (size_t i = len - 1; i-- > 0;)
+  {
+    Token *string = strings[i]->token;
+    for (size_t j = i + 1; j < len; j++)
+    {
+      Token *next = strings[j]->token;
+      if (string->len > next->len ||
+          memcmp(string->str, next->str + next->len - string->len,
+                 string->len))
+        break;
+      Var *root = container[j] ? container[j] : strings[j];
+      if (literal_offset(root->token, string->len, &offset[i]))
+      {
+        container[i] = root;
+        break;
+      }
+    }
+  }
+
+  output_file("    .section .rodata.str1.1,\"aMS\",@progbits,1");
+  for (size_t i = 0; i < len; i++)
+    if (!container[i])
+    {
+      output_file("%.*s:", (int)strings[i]->len, strings[i]->name);
+      output_file("    .string \"%.*s\"", (int)strings[i]->token->len,
+                  strings[i]->token->str);
+    }
+  for (size_t i = 0; i < len; i++)
+    if (container[i])
+      output_file("    .set %.*s, %.*s+%zu", (int)strings[i]->len,
+                  strings[i]->name, (int)container[i]->len, container[i]->name,
+                  offset[i]);
+  free(strings);
+  free(work);
+  free(container);
+  free(offset);
+}
 
 void generator(IRProgram *program, char *output_filename)
 {
   pr_debug("start generator");
 
   pr_debug("output filename: %.*s", strlen(output_filename), output_filename);
-  fout = fopen(output_filename, "w");
-  if (fout == NULL)
-    error_exit("cannot written to file");
+  output_open(output_filename);
   pr_debug("output file open");
   output_file("    .intel_syntax noprefix\n");
 
@@ -79,16 +192,7 @@ void generator(IRProgram *program, char *output_filename)
 
   // strings
   if (vector_size(program->strings))
-  {
-    output_file("    .section .rodata");
-    for (size_t i = 1; i <= vector_size(program->strings); i++)
-    {
-      Var *string = vector_peek_at(program->strings, i);
-      output_file("%.*s:", (int)string->len, string->name);
-      output_file("    .string \"%.*s\"", (int)string->token->len,
-                  string->token->str);
-    }
-  }
+    generate_strings(program->strings);
 
   // Write functions
   for (size_t i = 0; i < vector_size(program->functions); i++)
@@ -97,6 +201,6 @@ void generator(IRProgram *program, char *output_filename)
     generate_x64(func);
   }
 
-  fclose(fout);
+  output_close();
   pr_debug("Generation complete.");
 }
\ No newline at end of file
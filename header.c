@@ -0,0 +1,373 @@
+// ------------------------------------------------------------------------------------
+// header file manager
+// ------------------------------------------------------------------------------------
+
+#include "include/header.h"
+
+#ifdef SELF_HOST
+#include "test/compiler_header.h"
+#else
+#include <dirent.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#endif
+
+#include "include/define.h"
+#include "include/error.h"
+#include "include/file.h"
+#include "include/include_paths.h"
+#include "include/vector.h"
+
+// Headers by path. Each path spelling that has been looked up has its own
+// entry (alias) pointing to the header of the canonical path, so realpath()
+// runs once per spelling.
+typedef struct HeaderAlias HeaderAlias;
+
+struct HeaderAlias
+{
+  HeaderAlias *next;
+  Atom *path;
+  Header *header;
+};
+
+// Tokens of a header, from one position where tokenization starts up to where
+// it stops (see tokenizer()). They are kept unmodified and copied for every
+// #include, as the preprocessor rewrites the tokens it is given.
+struct HeaderChunk
+{
+  HeaderChunk *next;  // Next chunk in the file
+  char *start;        // Where tokenization started
+  char *rest;         // Where tokenization stopped, NULL at the end of file
+  Token *tokens;      // The last one is TK_EOF if rest is NULL
+};
+
+static HeaderAlias *alias_table[HEADER_TABLE_SIZE];
+Header *header_table[HEADER_TABLE_SIZE];  // Headers by canonical path
+
+// Names in a directory, read with readdir() when the directory is probed
+// first. Looking a header up in the listings replaces the fopen() calls that
+// fail for most of the include paths.
+typedef struct Directory Directory;
+
+struct Directory
+{
+  Directory *next;     // Next directory in the same hash bucket
+  Atom *path;          // Ends with '/', "" for the current directory
+  Atom **entries;      // Open addressing set of the names
+  size_t entries_size;  // Power of two, 0 if the directory cannot be read
+};
+
+// Result of a lookup of #include "name" from a directory, or of
+// #include <name>. Failed lookups are kept as well.
+typedef struct Resolution Resolution;
+
+struct Resolution
+{
+  Resolution *next;  // Next resolution in the same hash bucket
+  Atom *key;         // '"' or '<', the directory for '"', '\n' and the name
+  char *path;        // NULL if not found
+  bool is_system;    // Found in a system include path
+};
+
+static Directory *directory_table[HEADER_TABLE_SIZE];
+static Resolution *resolution_table[HEADER_TABLE_SIZE];
+
+// Include paths in search order, each ending with '/': -I paths, -isystem
+// paths and the paths of the system compiler (include_paths.h)
+static Vector *user_paths;
+static Vector *system_paths;
+
+// Adds an include path. -I paths (is_system false) are searched before
+// -isystem paths, both for #include "name" and #include <name>.
+void header_add_include_path(char *dir, bool is_system)
+{
+  Vector **paths = is_system ? &system_paths : &user_paths;
+  if (!*paths)
+    *paths = vector_new();
+  size_t len = strlen(dir);
+  bool has_slash = len && dir[len - 1] == '/';
+  char *path = malloc(len + 2);
+  memcpy(path, dir, len);
+  path[len] = '/';
+  path[len + !has_slash] = '\0';
+  vector_push(*paths, path);
+}
+
+static Directory *directory_read(Atom *path)
+{
+  Directory **bucket = &directory_table[path->hash & (HEADER_TABLE_SIZE - 1)];
+  for (Directory *directory = *bucket; directory; directory = directory->next)
+    if (directory->path == path)
+      return directory;
+
+  Directory *directory = calloc(1, sizeof(Directory));
+  directory->path = path;
+  directory->next = *bucket;
+  *bucket = directory;
+  DIR *dir = opendir(path->len ? path->str : ".");
+  if (!dir)
+    return directory;
+  Vector *names = vector_new();
+  for (struct dirent *entry = readdir(dir); entry; entry = readdir(dir))
+    vector_push(names, atom_intern(entry->d_name, strlen(entry->d_name)));
+  closedir(dir);
+
+  directory->entries_size = 16;
+  while (directory->entries_size < vector_size(names) * 2)
+    directory->entries_size *= 2;
+  directory->entries = calloc(directory->entries_size, sizeof(Atom *));
+  size_t mask = directory->entries_size - 1;
+  for (size_t i = 1; i <= vector_size(names); i++)
+  {
+    Atom *name = vector_peek_at(names, i);
+    size_t index = name->hash & mask;
+    while (directory->entries[index])
+      index = (index + 1) & mask;
+    directory->entries[index] = name;
+  }
+  pr_debug("read directory %s: %zu entries", directory->path->str,
+           vector_size(names));
+  vector_free(names);
+  return directory;
+}
+
+static bool directory_has(Directory *directory, char *name, size_t len)
+{
+  if (!directory->entries_size)
+    return false;
+  Atom *atom = atom_intern(name, len);
+  size_t mask = directory->entries_size - 1;
+  for (size_t index = atom->hash & mask; directory->entries[index];
+       index = (index + 1) & mask)
+    if (directory->entries[index] == atom)
+      return true;
+  return false;
+}
+
+// Returns the path of name in the directory dir (ending with '/'), or NULL if
+// the file does not exist. Each component of name is looked up in the
+// listing of its directory.
+static char *directory_lookup(char *dir, size_t dir_len, char *name)
+{
+  size_t name_len = strlen(name);
+  char *path = malloc(dir_len + name_len + 1);
+  memcpy(path, dir, dir_len);
+  memcpy(path + dir_len, name, name_len + 1);
+  char *component = path + dir_len;
+  for (;;)
+  {
+    char *end = strchr(component, '/');
+    size_t len = end ? (size_t)(end - component) : strlen(component);
+    Directory *directory =
+        directory_read(atom_intern(path, component - path));
+    if (len && !directory_has(directory, component, len))
+    {
+      free(path);
+      return NULL;
+    }
+    if (!end)
+      return path;
+    component = end + 1;
+  }
+}
+
+// Returns the path of the file of #include "name" (is_quoted) or
+// #include <name>, or NULL if it is not found. current_dir is the directory
+// of the including file, searched first for #include "name".
+// *is_system is set if it is found in a system include path (-isystem or
+// the paths of the system compiler).
+// The results of the lookups are memoized, including failed ones.
+char *header_resolve(char *name, bool is_quoted, char *current_dir,
+                     size_t current_dir_len, bool *is_system)
+{
+  if (!is_quoted)
+    current_dir_len = 0;
+  size_t name_len = strlen(name);
+  char *key_str = malloc(current_dir_len + name_len + 2);
+  key_str[0] = is_quoted ? '"' : '<';
+  memcpy(key_str + 1, current_dir, current_dir_len);
+  key_str[current_dir_len + 1] = '\n';
+  memcpy(key_str + current_dir_len + 2, name, name_len);
+  Atom *key = atom_intern(key_str, current_dir_len + name_len + 2);
+  free(key_str);
+  Resolution **bucket = &resolution_table[key->hash & (HEADER_TABLE_SIZE - 1)];
+  for (Resolution *resolution = *bucket; resolution;
+       resolution = resolution->next)
+    if (resolution->key == key)
+    {
+      *is_system = resolution->is_system;
+      return resolution->path;
+    }
+
+  char *path = NULL;
+  *is_system = false;
+  if (name[0] == '/')  // absolute path, no search
+    path = directory_lookup("/", 1, name + 1);
+  else
+  {
+    if (is_quoted)
+      path = directory_lookup(current_dir, current_dir_len, name);
+    for (size_t i = 1; !path && user_paths && i <= vector_size(user_paths);
+         i++)
+    {
+      char *dir = vector_peek_at(user_paths, i);
+      path = directory_lookup(dir, strlen(dir), name);
+    }
+    *is_system = !path;
+    for (size_t i = 1;
+         !path && system_paths && i <= vector_size(system_paths); i++)
+    {
+      char *dir = vector_peek_at(system_paths, i);
+      path = directory_lookup(dir, strlen(dir), name);
+    }
+    for (size_t i = 0; !path && i < sizeof(lib_path) / sizeof(char *); i++)
+      path = directory_lookup(lib_path[i], lib_path_size[i] - 1, name);
+  }
+  pr_debug("resolved %s: %s", name, path ? path : "(not found)");
+
+  Resolution *resolution = malloc(sizeof(Resolution));
+  resolution->key = key;
+  resolution->path = path;
+  resolution->is_system = *is_system;
+  resolution->next = *bucket;
+  *bucket = resolution;
+  return path;
+}
+
+// Returns the header of the file at path, creating it on the first call.
+// Different spellings of the same file return the same header.
+Header *header_find(char *path)
+{
+  Atom *path_atom = atom_intern(path, strlen(path));
+  HeaderAlias **alias_bucket =
+      &alias_table[path_atom->hash & (HEADER_TABLE_SIZE - 1)];
+  for (HeaderAlias *alias = *alias_bucket; alias; alias = alias->next)
+    if (alias->path == path_atom)
+      return alias->header;
+
+  char *canonical_path = realpath(path, NULL);
+  Atom *canonical = canonical_path
+                        ? atom_intern(canonical_path, strlen(canonical_path))
+                        : path_atom;
+  free(canonical_path);
+  Header **bucket = &header_table[canonical->hash & (HEADER_TABLE_SIZE - 1)];
+  Header *header = *bucket;
+  while (header && header->path != canonical)
+    header = header->next;
+  if (!header)
+  {
+    header = calloc(1, sizeof(Header));
+    header->path = canonical;
+    header->next = *bucket;
+    *bucket = header;
+  }
+
+  HeaderAlias *alias = malloc(sizeof(HeaderAlias));
+  alias->path = path_atom;
+  alias->header = header;
+  alias->next = *alias_bucket;
+  *alias_bucket = alias;
+  return header;
+}
+
+// Whether including the header again would have no effect: it has
+// #pragma once, or its include guard macro is defined
+bool header_is_skippable(Header *header)
+{
+  if (header->is_once)
+    return true;
+  if (!header->guard)
+    return false;
+  Token token;
+  token.kind = TK_IDENT;
+  token.str = header->guard->str;
+  token.len = header->guard->len;
+  token.atom = header->guard;
+  return find_macro_name_all(&token);
+}
+
+// Returns the content of the header read from fin, which is closed.
+// The content loaded last time is returned while the size and the
+// modification time of the file are unchanged.
+char *header_read(Header *header, FILE *fin)
+{
+  struct stat file_stat;
+  if (fstat(fileno(fin), &file_stat) == -1)
+    error_exit("failed to get file status: %s", strerror(errno));
+  if (header->content && (size_t)file_stat.st_size == header->size &&
+      file_stat.st_mtim.tv_sec == header->mtime.tv_sec &&
+      file_stat.st_mtim.tv_nsec == header->mtime.tv_nsec)
+  {
+    pr_debug("header cache hit: %s", header->path->str);
+    fclose(fin);
+    return header->content;
+  }
+  // The previous content is not released, the tokens made from it are in use
+  char *content = file_read(fin);
+  header->content = S_ISREG(file_stat.st_mode) ? content : NULL;
+  header->size = file_stat.st_size;
+  header->mtime = file_stat.st_mtim;
+  header->chunks = NULL;
+  header->cursor = NULL;
+  return content;
+}
+
+// Returns a copy of the tokens of chunk. The TK_EOF token is followed by
+// next_token.
+static Token *chunk_copy(HeaderChunk *chunk, Token *next_token)
+{
+  Token head;
+  Token *cur = &head;
+  for (Token *token = chunk->tokens; token; token = token->next)
+  {
+    cur->next = token_copy(token);
+    cur = cur->next;
+  }
+  cur->next = chunk->rest ? NULL : next_token;
+  return head.next;
+}
+
+// Tokenizes the header from input, which points into its content, like
+// tokenize_rest(). Each part of the content is tokenized once; later calls
+// return copies of the tokens.
+Token *header_tokenize(Header *header, char *input, Token *next_token,
+                       char **rest)
+{
+  *rest = input;
+  if (!header->content)
+    return tokenize_rest(rest, NULL, next_token);
+
+  // The chunks are sorted by position and mostly looked up in order
+  HeaderChunk **link = &header->chunks;
+  if (header->cursor && header->cursor->start <= input)
+    link = &header->cursor;
+  while (*link && (*link)->start < input)
+    link = &(*link)->next;
+  if (*link && (*link)->start == input)
+  {
+    header->cursor = *link;
+    *rest = (*link)->rest;
+    return chunk_copy(*link, next_token);
+  }
+
+  Token *tokens = tokenize_rest(rest, NULL, next_token);
+  HeaderChunk *chunk = malloc(sizeof(HeaderChunk));
+  chunk->start = input;
+  chunk->rest = *rest;
+  chunk->tokens = NULL;
+  Token **tail = &chunk->tokens;
+  for (Token *token = tokens; token; token = token->next)
+  {
+    *tail = token_copy(token);
+    tail = &(*tail)->next;
+    if (token->kind == TK_EOF)
+      break;
+  }
+  *tail = NULL;
+  chunk->next = *link;
+  *link = chunk;
+  header->cursor = chunk;
+  return tokens;
+}
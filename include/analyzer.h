@@ -3,7 +3,10 @@
 
 #include "parser.h"
 
+bool is_integer_type(Type *t);
 bool is_equal_type(Type *lhs, Type *rhs);
+Type *implicit_type_conversion(Type *lhs, Type *rhs);
+bool is_signed_comparison(Node *node);
 FuncBlock *analyzer(FuncBlock *funcblock);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef ATOM_C_COMPILER
+#define ATOM_C_COMPILER
+
+#ifdef SELF_HOST
+#include "../test/compiler_header.h"
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+typedef struct Atom Atom;
+
+// Integer constant suffixes
+#define NUMBER_UNSIGNED (1 << 0)  // u, U
+#define NUMBER_LONG (1 << 1)      // l, L
+#define NUMBER_LONGLONG (1 << 2)  // ll, LL
+
+// Interned name. There is only one Atom for each distinct string, so two
+// names are equal if and only if their atoms are the same pointer.
+struct Atom
+{
+  Atom *next;     // Next atom in the same hash bucket
+  char *str;      // Name (null-terminated copy)
+  uint32_t len;   // Length of name
+  uint32_t hash;  // Hash of name
+  int keyword;    // Keyword (see tokenizer.h), 0 if not a keyword
+
+  // Integer constant, decoded once by the tokenizer (see token_number())
+  uint8_t number_base;    // 2, 8, 10 or 16. 0 if not decoded yet
+  uint8_t number_suffix;  // NUMBER_UNSIGNED | NUMBER_LONG | NUMBER_LONGLONG
+  bool is_number;         // Whether the name is a valid integer constant
+  unsigned long long number_value;
+};
+
+uint32_t atom_hash(char *str, size_t len);
+Atom *atom_intern(char *str, size_t len);
+
+#endif
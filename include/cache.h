@@ -0,0 +1,19 @@
+#ifndef CACHE_C_COMPILER
+#define CACHE_C_COMPILER
+
+#ifdef SELF_HOST
+#include "../test/compiler_header.h"
+#else
+#include <stdbool.h>
+#include <stdint.h>
+#endif
+
+#include "tokenizer.h"
+
+bool cache_fetch(char *dir, Token *token, uint64_t options,
+                 char *output_file_name);
+char *cache_output_file_name();
+void cache_store(char *output_file_name);
+void cache_print_stats(char *dir);
+
+#endif  // CACHE_C_COMPILER
@@ -6,7 +6,7 @@
 #include "vector.h"
 
 void print_token_str(Vector *vec);
-void print_polish_notation();
+void bench_tokenizer(char *input);
 void print_tokenize_result(Token *token);
 void print_parse_result(FuncBlock *node);
 void print_mermaid_result(FuncBlock *node, char *output_file_name);
@@ -4,9 +4,6 @@
 #include "tokenizer.h"
 #include "vector.h"
 
-extern Vector *object_like_macro_list;
-extern Vector *function_like_macro_list;
-
 typedef struct object_like_macro_storage object_like_macro_storage;
 
 struct object_like_macro_storage
@@ -15,6 +12,27 @@ struct object_like_macro_storage
   Vector *token_string;
 };
 
+typedef enum
+{
+  MACRO_OP_TOKEN,      // Copy token
+  MACRO_OP_ARGUMENT,   // Insert the argument of parameter
+  MACRO_OP_STRINGIZE,  // # parameter
+  MACRO_OP_VA_COMMA,   // , ## __VA_ARGS__ (GNU): the comma is removed when
+                       // there are no variable arguments
+  MACRO_OP_VA_OPT,     // __VA_OPT__( ... ): the next skip ops are skipped
+                       // when there are no variable arguments
+} macro_op_kind;
+
+// One step of a compiled function-like macro replacement list
+typedef struct
+{
+  macro_op_kind kind;
+  bool is_paste;     // ## : paste the first inserted token to the one before
+  size_t parameter;  // Parameter number (1-based), __VA_ARGS__ is the last
+  size_t skip;       // MACRO_OP_VA_OPT
+  Token *token;      // MACRO_OP_TOKEN
+} macro_op;
+
 typedef struct function_like_macro_storage function_like_macro_storage;
 
 struct function_like_macro_storage
@@ -22,12 +40,27 @@ struct function_like_macro_storage
   Token *identifier;
   Vector *arguments;
   Vector *token_string;
+  bool is_variadic;  // The last parameter is "..."
+  macro_op *body;    // token_string compiled by add_function_like_macro()
+  size_t body_len;
 };
 
+typedef struct
+{
+  Atom *name;   // Macro name, NULL if the slot is empty
+  int kind;     // 1: object-like macro, 2: function-like macro
+  void *macro;  // object_like_macro_storage or function_like_macro_storage,
+                // NULL if not defined (#undef)
+} macro_slot;
+
+extern macro_slot *macro_table;
+extern size_t macro_table_size;
+
+void define_predefined_macros(bool gcc_compatible);
 int find_macro_name_all(Token *identifier);
 void add_object_like_macro(Vector *token);
 void add_function_like_macro(Vector *token);
-bool ident_replacement(Token *token);
+Token *ident_replacement(Token *token);
 void undef_macro(Token *token);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,16 @@
+#ifndef DEPENDENCY_C_COMPILER
+#define DEPENDENCY_C_COMPILER
+
+#ifdef SELF_HOST
+#include "../test/compiler_header.h"
+#else
+#include <stdbool.h>
+#endif
+
+#include "header.h"
+
+void dependency_add(Header *header, char *path, bool is_system);
+void dependency_write(char *filename, char *target, bool quote_target,
+                      char *input_file_name, bool is_phony, bool has_system);
+
+#endif  // DEPENDENCY_C_COMPILER
@@ -2,6 +2,7 @@
 #define GENERATOR_C_COMPILER
 
 #include "common.h"
+#include "output.h"
 
 void generator(IRProgram *program, char *output_filename);
 
@@ -26,12 +27,10 @@ void generator(IRProgram *program, char *output_filename);
 #define output_debug2(fmt, ...)
 #endif
 
-#define output_file(fmt, ...)               \
-  do                                        \
-  {                                         \
-    fprintf(fout, fmt "\n", ##__VA_ARGS__); \
+#define output_file(fmt, ...)                \
+  do                                         \
+  {                                          \
+    output_format(fmt "\n", ##__VA_ARGS__); \
   } while (0)
 
-extern FILE *fout;
-
 #endif  // GENERATOR_C_COMPILER
\ No newline at end of file
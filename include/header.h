@@ -0,0 +1,47 @@
+#ifndef HEADER_C_COMPILER
+#define HEADER_C_COMPILER
+
+#ifdef SELF_HOST
+#include "../test/compiler_header.h"
+#else
+#include <stdio.h>
+#include <time.h>
+#endif
+
+#include "atom.h"
+#include "tokenizer.h"
+
+#define HEADER_TABLE_SIZE 256  // must be a power of two
+
+typedef struct Header Header;
+typedef struct HeaderChunk HeaderChunk;
+
+// A file read by #include, identified by its canonical path
+struct Header
+{
+  Header *next;  // Next header in the same hash bucket
+  Atom *path;    // Canonical path
+  Atom *guard;   // Include guard macro, NULL if none was detected
+  bool is_once;  // #pragma once
+  bool is_dependency;  // Listed in the dependency output (-MD)
+
+  // Content cache, valid while the file is not modified
+  char *content;          // NULL if the file could not be cached
+  size_t size;            // File size of content
+  struct timespec mtime;  // Modification time of content
+  HeaderChunk *chunks;    // Tokens of content (see header_tokenize())
+  HeaderChunk *cursor;    // Chunk looked up last
+};
+
+extern Header *header_table[HEADER_TABLE_SIZE];
+
+void header_add_include_path(char *dir, bool is_system);
+char *header_resolve(char *name, bool is_quoted, char *current_dir,
+                     size_t current_dir_len, bool *is_system);
+Header *header_find(char *path);
+bool header_is_skippable(Header *header);
+char *header_read(Header *header, FILE *fin);
+Token *header_tokenize(Header *header, char *input, Token *next_token,
+                       char **rest);
+
+#endif  // HEADER_C_COMPILER
@@ -0,0 +1,27 @@
+#ifndef INCLUDE_PATHS_H
+#define INCLUDE_PATHS_H
+
+#include <stddef.h>
+
+static char include_path_1[] = "/usr/lib/gcc/x86_64-linux-gnu/12/include/";
+static char include_path_2[] = "/usr/local/include/";
+static char include_path_3[] = "/usr/include/x86_64-linux-gnu/";
+static char include_path_4[] = "/usr/include/";
+
+static char *lib_path[] = {
+    include_path_1,
+    include_path_2,
+    include_path_3,
+    include_path_4,
+};
+
+static size_t lib_path_size[] = {
+    sizeof(include_path_1),
+    sizeof(include_path_2),
+    sizeof(include_path_3),
+    sizeof(include_path_4),
+};
+
+#define MAX_LIB_PATH_SIZE sizeof(include_path_1)
+
+#endif // INCLUDE_PATHS_H
@@ -0,0 +1,20 @@
+#ifndef OUTPUT_C_COMPILER
+#define OUTPUT_C_COMPILER
+
+#ifdef SELF_HOST
+#include "../test/compiler_header.h"
+#else
+#include <stddef.h>
+#endif
+
+void output_reserve_stdout();
+void output_open(char *filename);
+void output_write(char *str, size_t len);
+void output_char(char c);
+void output_string(char *str);
+void output_signed(long long value);
+void output_unsigned(unsigned long long value);
+void output_format(char *fmt, ...);
+void output_close();
+
+#endif  // OUTPUT_C_COMPILER
@@ -225,6 +225,10 @@ struct FuncBlock
 };
 
 FuncBlock *get_funcblock_head();
+void *ast_alloc(size_t size);
+void ast_arena_free();
+size_t node_size(NodeKind kind);
+Node *node_alloc(NodeKind kind);
 Node *new_node(NodeKind kind, Node *lhs, Node *rhs, Token *token);
 Node *new_node_num(long long val);
 Node *constant_expression();
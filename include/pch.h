@@ -0,0 +1,16 @@
+#ifndef PCH_C_COMPILER
+#define PCH_C_COMPILER
+
+#include "tokenizer.h"
+
+void pch_write(Token *token, Token *declarations, char *filename);
+Token *pch_read(char *filename, bool *has_types);
+
+// Used by the sections written by other modules
+void pch_write_u32(size_t value);
+void pch_write_string(char *str, size_t len);
+uint32_t pch_read_u32();
+char *pch_read_string(uint32_t *len);
+Token *pch_read_identifier();
+
+#endif  // PCH_C_COMPILER
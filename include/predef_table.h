@@ -0,0 +1,1284 @@
+#ifndef PREDEF_TABLE_H
+#define PREDEF_TABLE_H
+
+// Generated by build.sh
+
+#define PREDEF_INDEX_SIZE 1024
+
+static predef_token predef_tokens[] = {
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "1021"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 6, "0xffff"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 4, "4932"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "17549435082228750796873653722224568e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 3, "38F"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 4, "char"},
+    {TK_IDENT, 2, "16"},
+    {TK_IDENT, 1, "c"},
+    {TK_IDENT, 1, "c"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_DIRECTIVE, 1, "#"},
+    {TK_DIRECTIVE, 1, "#"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 1, "L"},
+    {TK_IDENT, 1, "8"},
+    {TK_IDENT, 4, "0xff"},
+    {TK_IDENT, 1, "8"},
+    {TK_IDENT, 11, "0xffffffffU"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 3, "125"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 4, "1234"},
+    {TK_IDENT, 20, "0xffffffffffffffffUL"},
+    {TK_IDENT, 10, "0x7fffffff"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 2, "17"},
+    {TK_IDENT, 1, "0"},
+    {TK_IDENT, 2, "17"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 20, "0xffffffffffffffffUL"},
+    {TK_IDENT, 3, "int"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 3, "307"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "0"},
+    {TK_IDENT, 4, "1024"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 4, "0xff"},
+    {TK_IDENT, 2, "38"},
+    {TK_IDENT, 3, "385"},
+    {TK_IDENT, 1, "c"},
+    {TK_IDENT, 1, "c"},
+    {TK_IDENT, 1, "8"},
+    {TK_IDENT, 20, "0xffffffffffffffffUL"},
+    {TK_IDENT, 6, "0x7fff"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "18973149535723176502126385303097021e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 5, "4932L"},
+    {TK_IDENT, 4, "4932"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 4, "0xff"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 1, "6"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "47517511943802511092443895822764655e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 8, "4966F128"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 2, "1E"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 3, "6DF"},
+    {TK_IDENT, 1, "0"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 11, "0xffffffffU"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "("},
+    {TK_IDENT, 6, "double"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "4"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "94065645841246544176568792868221372e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "324L"},
+    {TK_RESERVED, 1, ")"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 5, "16381"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 2, "0U"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "4931"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 2, "16"},
+    {TK_IDENT, 4, "0x7f"},
+    {TK_IDENT, 3, "113"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 13, "__WCHAR_MAX__"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_RESERVED, 1, "-"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "c"},
+    {TK_IDENT, 1, "c"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_DIRECTIVE, 1, "#"},
+    {TK_DIRECTIVE, 1, "#"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 1, "L"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 2, "53"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "08420217248550443400745280086994171e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 6, "19F64x"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 3, "382"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 2, "15"},
+    {TK_IDENT, 1, "6"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "19209289550781250000000000000000000e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 2, "7F"},
+    {TK_IDENT, 2, "16"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 1, "3"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "36210314311209350626267781732175260e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 5, "4932L"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 1, "9"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 11, "999999E96DF"},
+    {TK_IDENT, 1, "3"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "64519953188247460252840593361941982e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 8, "4951F64x"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 10, "0x7fffffff"},
+    {TK_IDENT, 1, "3"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 2, "32"},
+    {TK_IDENT, 1, "8"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 7, "201706L"},
+    {TK_IDENT, 1, "c"},
+    {TK_IDENT, 1, "c"},
+    {TK_IDENT, 2, "21"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "2"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "22044604925031308084726333618164062e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 5, "16F64"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "2"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "4931"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 2, "13"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 2, "53"},
+    {TK_IDENT, 2, "64"},
+    {TK_IDENT, 2, "12"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 2, "16"},
+    {TK_IDENT, 2, "16"},
+    {TK_IDENT, 3, "308"},
+    {TK_IDENT, 1, "4"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "("},
+    {TK_IDENT, 6, "double"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "79769313486231570814527423731704357e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 4, "308L"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 19, "0x7fffffffffffffffL"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "4"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 2, "94"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 2, "64"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 11, "0xffffffffU"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 2, "1E"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "95DF"},
+    {TK_IDENT, 4, "1024"},
+    {TK_IDENT, 2, "32"},
+    {TK_IDENT, 1, "3"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "40282346638528859811704183484516925e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 5, "38F32"},
+    {TK_IDENT, 2, "1E"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "33DL"},
+    {TK_IDENT, 1, "5"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 6, "131072"},
+    {TK_IDENT, 19, "0x7fffffffffffffffL"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 5, "65536"},
+    {TK_IDENT, 20, "0x7fffffffffffffffLL"},
+    {TK_IDENT, 1, "8"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 5, "16381"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "4"},
+    {TK_IDENT, 2, "64"},
+    {TK_IDENT, 3, "128"},
+    {TK_IDENT, 4, "1017"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 3, "125"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 6, "0x7fff"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "4"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "94065645841246544176568792868221372e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 6, "324F64"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "("},
+    {TK_IDENT, 6, "double"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "2"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "22507385850720138309023271733240406e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "308L"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "5"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "96046447753906250000000000000000000e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "8F16"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "92592994438723585305597794258492732e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 6, "34F128"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "18973149535723176502126385303097021e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 8, "4932F64x"},
+    {TK_IDENT, 1, "8"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "2"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "22044604925031308084726333618164062e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 6, "16F32x"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "1021"},
+    {TK_RESERVED, 1, ")"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 3, "307"},
+    {TK_RESERVED, 1, ")"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 1, "4"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 2, "21"},
+    {TK_IDENT, 2, "1E"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 6, "6143DL"},
+    {TK_IDENT, 6, "0xffff"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "17549435082228750796873653722224568e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 5, "38F32"},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 4, "char"},
+    {TK_IDENT, 1, "6"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 1, "9"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 40, "999999999999999999999999999999999E6144DL"},
+    {TK_IDENT, 2, "24"},
+    {TK_IDENT, 2, "21"},
+    {TK_STRING, 6, "12.2.0"},
+    {TK_IDENT, 1, "c"},
+    {TK_IDENT, 1, "c"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_DIRECTIVE, 1, "#"},
+    {TK_DIRECTIVE, 1, "#"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 2, "UL"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 10, "0x7fffffff"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 5, "16384"},
+    {TK_IDENT, 2, "24"},
+    {TK_IDENT, 23, "__ORDER_LITTLE_ENDIAN__"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "1021"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 7, "201404L"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "9"},
+    {TK_IDENT, 2, "33"},
+    {TK_IDENT, 1, "c"},
+    {TK_IDENT, 1, "c"},
+    {TK_IDENT, 2, "1E"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "15DD"},
+    {TK_IDENT, 4, "3412"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "6142"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 5, "short"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 20, "0xffffffffffffffffUL"},
+    {TK_IDENT, 1, "2"},
+    {TK_STRING, 8, "UTF-32LE"},
+    {TK_IDENT, 2, "18"},
+    {TK_IDENT, 6, "signed"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 4, "char"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 5, "short"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "08420217248550443400745280086994171e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 3, "19L"},
+    {TK_IDENT, 1, "c"},
+    {TK_IDENT, 1, "c"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_DIRECTIVE, 1, "#"},
+    {TK_DIRECTIVE, 1, "#"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 2, "UL"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "2"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "22507385850720138309023271733240406e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 7, "308F32x"},
+    {TK_IDENT, 10, "0x7fffffff"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 7, "201404L"},
+    {TK_IDENT, 1, "8"},
+    {TK_IDENT, 2, "18"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 2, "16"},
+    {TK_IDENT, 1, "0"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 7, "000001E"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "95DF"},
+    {TK_IDENT, 19, "0x7fffffffffffffffL"},
+    {TK_IDENT, 2, "64"},
+    {TK_IDENT, 2, "15"},
+    {TK_IDENT, 20, "0xffffffffffffffffUL"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "9"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "76562500000000000000000000000000000e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "4F16"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 2, "38"},
+    {TK_IDENT, 19, "0x7fffffffffffffffL"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "0"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 34, "000000000000000000000000000000001E"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 6, "6143DL"},
+    {TK_IDENT, 1, "1"},
+    {TK_STRING, 5, "UTF-8"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "9"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 21, "999999999999999E384DD"},
+    {TK_IDENT, 2, "64"},
+    {TK_IDENT, 5, "short"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 2, "64"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 6, "0x7fff"},
+    {TK_IDENT, 1, "6"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "55040000000000000000000000000000000e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 4, "4F16"},
+    {TK_IDENT, 2, "16"},
+    {TK_IDENT, 19, "0x7fffffffffffffffL"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "40129846432481707092372958328991613e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 5, "45F32"},
+    {TK_IDENT, 2, "32"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 5, "short"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 6, "signed"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 4, "char"},
+    {TK_IDENT, 1, "6"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "55040000000000000000000000000000000e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 4, "4F16"},
+    {TK_IDENT, 7, "201710L"},
+    {TK_IDENT, 1, "4"},
+    {TK_IDENT, 2, "97"},
+    {TK_IDENT, 4, "0x7f"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "18973149535723176508575932662800702e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 8, "4932F128"},
+    {TK_IDENT, 19, "0x7fffffffffffffffL"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 2, "37"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 2, "15"},
+    {TK_IDENT, 2, "64"},
+    {TK_IDENT, 2, "64"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "18973149535723176502126385303097021e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 8, "4932F64x"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 18, "__SIG_ATOMIC_MAX__"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_RESERVED, 1, "-"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 1, "7"},
+    {TK_IDENT, 2, "11"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 5, "short"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 20, "0xffffffffffffffffUL"},
+    {TK_IDENT, 2, "64"},
+    {TK_IDENT, 19, "0x7fffffffffffffffL"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "3"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "40282346638528859811704183484516925e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 3, "38F"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 5, "16384"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 10, "0x7fffffff"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 3, "128"},
+    {TK_IDENT, 4, "4321"},
+    {TK_IDENT, 2, "53"},
+    {TK_IDENT, 2, "16"},
+    {TK_IDENT, 19, "0x7fffffffffffffffL"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 2, "1E"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 5, "383DD"},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 1, "3"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "40282346638528859811704183484516925e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 5, "38F32"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 5, "16381"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "79769313486231570814527423731704357e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 6, "308F64"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 2, "32"},
+    {TK_IDENT, 4, "0x7f"},
+    {TK_IDENT, 2, "64"},
+    {TK_IDENT, 5, "16384"},
+    {TK_IDENT, 3, "308"},
+    {TK_IDENT, 2, "16"},
+    {TK_IDENT, 1, "6"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "10351562500000000000000000000000000e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "5F16"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 4, "4932"},
+    {TK_IDENT, 1, "0"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "("},
+    {TK_IDENT, 6, "double"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "2"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "22044604925031308084726333618164062e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 3, "16L"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "3"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "36210314311209350626267781732175260e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 8, "4932F128"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "c"},
+    {TK_IDENT, 1, "c"},
+    {TK_IDENT, 4, "1024"},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "4"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "0"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "18973149535723176508575932662800702e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 8, "4932F128"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "79769313486231570814527423731704357e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 6, "308F64"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 19, "0x7fffffffffffffffL"},
+    {TK_IDENT, 6, "signed"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 4, "char"},
+    {TK_IDENT, 1, "3"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "36210314311209350626267781732175260e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 8, "4932F64x"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "19209289550781250000000000000000000e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "7F32"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 2, "17"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "8"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "79769313486231570814527423731704357e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 7, "308F32x"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "("},
+    {TK_IDENT, 6, "double"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "79769313486231570814527423731704357e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 4, "308L"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 23, "__ORDER_LITTLE_ENDIAN__"},
+    {TK_IDENT, 2, "64"},
+    {TK_IDENT, 2, "64"},
+    {TK_IDENT, 1, "c"},
+    {TK_IDENT, 1, "c"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_DIRECTIVE, 1, "#"},
+    {TK_DIRECTIVE, 1, "#"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 1, "U"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "40129846432481707092372958328991613e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 3, "45F"},
+    {TK_IDENT, 4, "0x7f"},
+    {TK_IDENT, 2, "64"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "79769313486231570814527423731704357e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 7, "308F32x"},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "3"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "40282346638528859811704183484516925e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 3, "38F"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "8"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 2, "37"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "2"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "22507385850720138309023271733240406e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 6, "308F64"},
+    {TK_IDENT, 2, "32"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 4, "6145"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 2, "64"},
+    {TK_IDENT, 20, "0xffffffffffffffffUL"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 1, "4"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "94065645841246544176568792868221372e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 7, "324F32x"},
+    {TK_IDENT, 3, "308"},
+    {TK_IDENT, 1, "3"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "64519953188247460252840593361941982e"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 5, "4951L"},
+    {TK_IDENT, 1, "c"},
+    {TK_IDENT, 1, "c"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "5"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 3, "307"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 4, "long"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 3, "int"},
+    {TK_IDENT, 1, "0"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 16, "000000000000001E"},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 5, "383DD"},
+    {TK_IDENT, 2, "34"},
+    {TK_RESERVED, 1, "("},
+    {TK_RESERVED, 1, "-"},
+    {TK_IDENT, 4, "4931"},
+    {TK_RESERVED, 1, ")"},
+    {TK_IDENT, 1, "8"},
+    {TK_IDENT, 2, "36"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 1, "1"},
+    {TK_IDENT, 1, "9"},
+    {TK_IDENT, 20, "0xffffffffffffffffUL"},
+    {TK_IDENT, 1, "1"},
+    {TK_RESERVED, 1, "."},
+    {TK_IDENT, 36, "18973149535723176502126385303097021e"},
+    {TK_RESERVED, 1, "+"},
+    {TK_IDENT, 5, "4932L"},
+    {TK_IDENT, 1, "2"},
+    {TK_IDENT, 8, "unsigned"},
+    {TK_IGNORABLE, 1, " "},
+    {TK_IDENT, 4, "char"},
+    {TK_IDENT, 1, "4"},
+    {TK_IDENT, 1, "3"},
+};
+
+static predef_macro predef_macros[] = {
+    {"__FILE__", 8, 4227372987u, false, 1, 0, 0, 0, 0},
+    {"__LINE__", 8, 3149002151u, false, 1, 0, 0, 0, 0},
+    {"__DATE__", 8, 2128234629u, false, 1, 0, 0, 0, 0},
+    {"__TIME__", 8, 429993376u, false, 1, 0, 0, 0, 0},
+    {"__INCLUDE_LEVEL__", 17, 1445234942u, false, 1, 0, 0, 0, 0},
+    {"__MYCC__", 8, 1065623669u, false, 1, 0, 0, 0, 0},
+    {"SELF_HOST", 9, 1804342122u, false, 1, 0, 0, 0, 0},
+    {"__DBL_MIN_EXP__", 15, 2291934294u, true, 1, 0, 0, 0, 4},
+    {"__UINT_LEAST16_MAX__", 20, 247071425u, true, 1, 4, 0, 4, 1},
+    {"__FLT16_HAS_QUIET_NAN__", 23, 2207841392u, true, 1, 5, 0, 5, 1},
+    {"__ATOMIC_ACQUIRE", 16, 958363861u, true, 1, 6, 0, 6, 1},
+    {"__FLT128_MAX_10_EXP__", 21, 959265017u, true, 1, 7, 0, 7, 1},
+    {"__FLT_MIN__", 11, 3188585882u, true, 1, 8, 0, 8, 5},
+    {"__GCC_IEC_559_COMPLEX", 21, 922617503u, true, 1, 13, 0, 13, 1},
+    {"__UINT_LEAST8_TYPE__", 20, 1052203118u, true, 1, 14, 0, 14, 3},
+    {"__SIZEOF_FLOAT80__", 18, 4050680932u, true, 1, 17, 0, 17, 1},
+    {"__INTMAX_C", 10, 3163652484u, true, 2, 18, 1, 19, 6},
+    {"__CHAR_BIT__", 12, 1043144181u, true, 1, 25, 0, 25, 1},
+    {"__UINT8_MAX__", 13, 2135799562u, true, 1, 26, 0, 26, 1},
+    {"__SCHAR_WIDTH__", 15, 250339985u, true, 1, 27, 0, 27, 1},
+    {"__WINT_MAX__", 12, 1342160006u, true, 1, 28, 0, 28, 1},
+    {"__FLT32_MIN_EXP__", 17, 100704915u, true, 1, 29, 0, 29, 4},
+    {"__ORDER_LITTLE_ENDIAN__", 23, 1215568426u, true, 1, 33, 0, 33, 1},
+    {"__SIZE_MAX__", 12, 449133341u, true, 1, 34, 0, 34, 1},
+    {"__WCHAR_MAX__", 13, 2927181783u, true, 1, 35, 0, 35, 1},
+    {"__GCC_HAVE_SYNC_COMPARE_AND_SWAP_2", 34, 159164174u, true, 1, 36, 0, 36, 1},
+    {"__GCC_HAVE_SYNC_COMPARE_AND_SWAP_4", 34, 192719412u, true, 1, 37, 0, 37, 1},
+    {"__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8", 34, 4286355280u, true, 1, 38, 0, 38, 1},
+    {"__GCC_ATOMIC_CHAR_LOCK_FREE", 27, 2253418046u, true, 1, 39, 0, 39, 1},
+    {"__GCC_IEC_559", 13, 1353156144u, true, 1, 40, 0, 40, 1},
+    {"__FLT32X_DECIMAL_DIG__", 22, 1003031315u, true, 1, 41, 0, 41, 1},
+    {"__FLT_EVAL_METHOD__", 19, 940587096u, true, 1, 42, 0, 42, 1},
+    {"__FLT64_DECIMAL_DIG__", 21, 8424260u, true, 1, 43, 0, 43, 1},
+    {"__GCC_ATOMIC_CHAR32_T_LOCK_FREE", 31, 3712095148u, true, 1, 44, 0, 44, 1},
+    {"__UINT_FAST64_MAX__", 19, 1593660943u, true, 1, 45, 0, 45, 1},
+    {"__SIG_ATOMIC_TYPE__", 19, 3014056775u, true, 1, 46, 0, 46, 1},
+    {"__DBL_MIN_10_EXP__", 18, 4273216210u, true, 1, 47, 0, 47, 4},
+    {"__FINITE_MATH_ONLY__", 20, 4035621884u, true, 1, 51, 0, 51, 1},
+    {"__FLT32X_MAX_EXP__", 18, 1931791537u, true, 1, 52, 0, 52, 1},
+    {"__GCC_HAVE_SYNC_COMPARE_AND_SWAP_1", 34, 142386555u, true, 1, 53, 0, 53, 1},
+    {"__FLT32_HAS_DENORM__", 20, 2726520729u, true, 1, 54, 0, 54, 1},
+    {"__UINT_FAST8_MAX__", 18, 2844203729u, true, 1, 55, 0, 55, 1},
+    {"__FLT32_MAX_10_EXP__", 20, 1697679163u, true, 1, 56, 0, 56, 1},
+    {"__DEC64_MAX_EXP__", 17, 1106680604u, true, 1, 57, 0, 57, 1},
+    {"__INT8_C", 8, 3620436718u, true, 2, 58, 1, 59, 1},
+    {"__INT_LEAST8_WIDTH__", 20, 2310962875u, true, 1, 60, 0, 60, 1},
+    {"__UINT_LEAST64_MAX__", 20, 2822611044u, true, 1, 61, 0, 61, 1},
+    {"__SHRT_MAX__", 12, 714900793u, true, 1, 62, 0, 62, 1},
+    {"__LDBL_MAX__", 12, 3601921302u, true, 1, 63, 0, 63, 5},
+    {"__FLT64X_MAX_10_EXP__", 21, 1880076316u, true, 1, 68, 0, 68, 1},
+    {"__LDBL_IS_IEC_60559__", 21, 3124749932u, true, 1, 69, 0, 69, 1},
+    {"__FLT64X_HAS_QUIET_NAN__", 24, 2998299355u, true, 1, 70, 0, 70, 1},
+    {"__UINT_LEAST8_MAX__", 19, 2573517060u, true, 1, 71, 0, 71, 1},
+    {"__GCC_ATOMIC_BOOL_LOCK_FREE", 27, 1053197626u, true, 1, 72, 0, 72, 1},
+    {"__FLT128_DENORM_MIN__", 21, 3612137185u, true, 1, 73, 0, 73, 5},
+    {"__UINTMAX_TYPE__", 16, 4117196578u, true, 1, 78, 0, 78, 5},
+    {"__linux", 7, 3444052883u, true, 1, 83, 0, 83, 1},
+    {"__DEC32_EPSILON__", 17, 2276890367u, true, 1, 84, 0, 84, 3},
+    {"__FLT_EVAL_METHOD_TS_18661_3__", 30, 17515157u, true, 1, 87, 0, 87, 1},
+    {"__unix", 6, 3416448797u, true, 1, 88, 0, 88, 1},
+    {"__UINT32_MAX__", 14, 2119614121u, true, 1, 89, 0, 89, 1},
+    {"__DBL_DENORM_MIN__", 18, 3452531360u, true, 1, 90, 0, 90, 10},
+    {"__FLT128_MIN_EXP__", 18, 3675960981u, true, 1, 100, 0, 100, 4},
+    {"__WINT_MIN__", 12, 1505278400u, true, 1, 104, 0, 104, 1},
+    {"__FLT128_MIN_10_EXP__", 21, 3951791947u, true, 1, 105, 0, 105, 4},
+    {"__FLT32X_IS_IEC_60559__", 23, 497270849u, true, 1, 109, 0, 109, 1},
+    {"__INT_LEAST16_WIDTH__", 21, 633649392u, true, 1, 110, 0, 110, 1},
+    {"__SCHAR_MAX__", 13, 4215821467u, true, 1, 111, 0, 111, 1},
+    {"__FLT128_MANT_DIG__", 19, 3407257296u, true, 1, 112, 0, 112, 1},
+    {"__WCHAR_MIN__", 13, 352461445u, true, 1, 113, 0, 113, 8},
+    {"__INT64_C", 9, 2385904032u, true, 2, 121, 1, 122, 6},
+    {"__GCC_ATOMIC_POINTER_LOCK_FREE", 30, 3635650417u, true, 1, 128, 0, 128, 1},
+    {"__FLT32X_MANT_DIG__", 19, 1970495498u, true, 1, 129, 0, 129, 1},
+    {"__FLT64X_EPSILON__", 18, 345531512u, true, 1, 130, 0, 130, 5},
+    {"__STDC_HOSTED__", 15, 143674515u, true, 1, 135, 0, 135, 1},
+    {"__DEC64_MIN_EXP__", 17, 1366714166u, true, 1, 136, 0, 136, 4},
+    {"__DBL_DIG__", 11, 3959664850u, true, 1, 140, 0, 140, 1},
+    {"__FLT32_DIG__", 13, 606782331u, true, 1, 141, 0, 141, 1},
+    {"__FLT_EPSILON__", 15, 4080819720u, true, 1, 142, 0, 142, 5},
+    {"__SHRT_WIDTH__", 14, 3066201843u, true, 1, 147, 0, 147, 1},
+    {"__FLT32_IS_IEC_60559__", 22, 3730946469u, true, 1, 148, 0, 148, 1},
+    {"__LDBL_MIN__", 12, 794507696u, true, 1, 149, 0, 149, 5},
+    {"__STDC_UTF_16__", 15, 364498517u, true, 1, 154, 0, 154, 1},
+    {"__DBL_IS_IEC_60559__", 20, 881116934u, true, 1, 155, 0, 155, 1},
+    {"__DEC32_MAX__", 13, 3240704771u, true, 1, 156, 0, 156, 3},
+    {"__FLT64X_DENORM_MIN__", 21, 1499858572u, true, 1, 159, 0, 159, 5},
+    {"__FLT32X_HAS_INFINITY__", 23, 2260112768u, true, 1, 164, 0, 164, 1},
+    {"__INT32_MAX__", 13, 1802786366u, true, 1, 165, 0, 165, 1},
+    {"__FLT16_DIG__", 13, 1103497541u, true, 1, 166, 0, 166, 1},
+    {"__unix__", 8, 2176237371u, true, 1, 167, 0, 167, 1},
+    {"__INT_WIDTH__", 13, 3615948945u, true, 1, 168, 0, 168, 1},
+    {"__SIZEOF_LONG__", 15, 1137281352u, true, 1, 169, 0, 169, 1},
+    {"__STDC_IEC_559__", 16, 3185501837u, true, 1, 170, 0, 170, 1},
+    {"__STDC_ISO_10646__", 18, 1924185225u, true, 1, 171, 0, 171, 1},
+    {"__UINT16_C", 10, 1001265042u, true, 2, 172, 1, 173, 1},
+    {"__DECIMAL_DIG__", 15, 2435279851u, true, 1, 174, 0, 174, 1},
+    {"__STDC_IEC_559_COMPLEX__", 24, 311966802u, true, 1, 175, 0, 175, 1},
+    {"__FLT64_EPSILON__", 17, 2986603926u, true, 1, 176, 0, 176, 5},
+    {"__gnu_linux__", 13, 3157925214u, true, 1, 181, 0, 181, 1},
+    {"__FLT128_IS_IEC_60559__", 23, 2537092575u, true, 1, 182, 0, 182, 1},
+    {"__FLT64X_MIN_10_EXP__", 21, 2418200854u, true, 1, 183, 0, 183, 4},
+    {"__LDBL_HAS_QUIET_NAN__", 22, 242543305u, true, 1, 187, 0, 187, 1},
+    {"__FLT16_MIN_EXP__", 17, 3773901985u, true, 1, 188, 0, 188, 4},
+    {"__FLT64_MANT_DIG__", 18, 1193701683u, true, 1, 192, 0, 192, 1},
+    {"__FLT64X_MANT_DIG__", 19, 1042686921u, true, 1, 193, 0, 193, 1},
+    {"__GNUC__", 8, 2577720996u, true, 1, 194, 0, 194, 1},
+    {"__pie__", 7, 1907120877u, true, 1, 195, 0, 195, 1},
+    {"__MMX__", 7, 2629677109u, true, 1, 196, 0, 196, 1},
+    {"__FLT_HAS_DENORM__", 18, 730199018u, true, 1, 197, 0, 197, 1},
+    {"__SIZEOF_LONG_DOUBLE__", 22, 4176750176u, true, 1, 198, 0, 198, 1},
+    {"__BIGGEST_ALIGNMENT__", 21, 1152045064u, true, 1, 199, 0, 199, 1},
+    {"__FLT64_MAX_10_EXP__", 20, 1312623618u, true, 1, 200, 0, 200, 1},
+    {"__FLT16_MAX_10_EXP__", 20, 3070930253u, true, 1, 201, 0, 201, 1},
+    {"__DBL_MAX__", 11, 2648998368u, true, 1, 202, 0, 202, 10},
+    {"__INT_FAST32_MAX__", 18, 1151603041u, true, 1, 212, 0, 212, 1},
+    {"__DBL_HAS_INFINITY__", 20, 2498677755u, true, 1, 213, 0, 213, 1},
+    {"__SIZEOF_FLOAT__", 16, 1926118412u, true, 1, 214, 0, 214, 1},
+    {"__HAVE_SPECULATION_SAFE_VALUE", 29, 363331717u, true, 1, 215, 0, 215, 1},
+    {"__DEC32_MIN_EXP__", 17, 728512681u, true, 1, 216, 0, 216, 4},
+    {"__INTPTR_WIDTH__", 16, 52995403u, true, 1, 220, 0, 220, 1},
+    {"__FLT64X_HAS_INFINITY__", 23, 3371211951u, true, 1, 221, 0, 221, 1},
+    {"__UINT_LEAST32_MAX__", 20, 3740767831u, true, 1, 222, 0, 222, 1},
+    {"__FLT32X_HAS_DENORM__", 21, 3072358261u, true, 1, 223, 0, 223, 1},
+    {"__INT_FAST16_TYPE__", 19, 415338915u, true, 1, 224, 0, 224, 3},
+    {"__MMX_WITH_SSE__", 16, 2156280048u, true, 1, 227, 0, 227, 1},
+    {"__LDBL_HAS_DENORM__", 19, 3845477060u, true, 1, 228, 0, 228, 1},
+    {"__SEG_GS", 8, 3790571759u, true, 1, 229, 0, 229, 1},
+    {"__FLT128_HAS_INFINITY__", 23, 860340606u, true, 1, 230, 0, 230, 1},
+    {"__DEC32_MIN__", 13, 754237929u, true, 1, 231, 0, 231, 3},
+    {"__DBL_MAX_EXP__", 15, 810280636u, true, 1, 234, 0, 234, 1},
+    {"__WCHAR_WIDTH__", 15, 3575185485u, true, 1, 235, 0, 235, 1},
+    {"__FLT32_MAX__", 13, 4039292277u, true, 1, 236, 0, 236, 5},
+    {"__DEC128_EPSILON__", 18, 3605539981u, true, 1, 241, 0, 241, 3},
+    {"__FLT16_DECIMAL_DIG__", 21, 440932745u, true, 1, 244, 0, 244, 1},
+    {"__SSE2_MATH__", 13, 529376887u, true, 1, 245, 0, 245, 1},
+    {"__ATOMIC_HLE_RELEASE", 20, 450204832u, true, 1, 246, 0, 246, 1},
+    {"__PTRDIFF_MAX__", 15, 1066123587u, true, 1, 247, 0, 247, 1},
+    {"__amd64", 7, 1483541373u, true, 1, 248, 0, 248, 1},
+    {"__ATOMIC_HLE_ACQUIRE", 20, 3095008285u, true, 1, 249, 0, 249, 1},
+    {"__LONG_LONG_MAX__", 17, 1614892991u, true, 1, 250, 0, 250, 1},
+    {"__SIZEOF_SIZE_T__", 17, 3712681196u, true, 1, 251, 0, 251, 1},
+    {"__FLT64X_MIN_EXP__", 18, 3563258666u, true, 1, 252, 0, 252, 4},
+    {"__SIZEOF_WINT_T__", 17, 656666911u, true, 1, 256, 0, 256, 1},
+    {"__LONG_LONG_WIDTH__", 19, 290131413u, true, 1, 257, 0, 257, 1},
+    {"__FLT32_MAX_EXP__", 17, 798057093u, true, 1, 258, 0, 258, 1},
+    {"__GXX_ABI_VERSION", 17, 2159147634u, true, 1, 259, 0, 259, 1},
+    {"__FLT_MIN_EXP__", 15, 3613684314u, true, 1, 260, 0, 260, 4},
+    {"__GCC_HAVE_DWARF2_CFI_ASM", 25, 3469027871u, true, 1, 264, 0, 264, 1},
+    {"__INT16_MAX__", 13, 2769913128u, true, 1, 265, 0, 265, 1},
+    {"__x86_64", 8, 3043129626u, true, 1, 266, 0, 266, 1},
+    {"__INT_FAST64_TYPE__", 19, 3292801184u, true, 1, 267, 0, 267, 3},
+    {"__FLT64_DENORM_MIN__", 20, 409946398u, true, 1, 270, 0, 270, 5},
+    {"__DBL_MIN__", 11, 1161444678u, true, 1, 275, 0, 275, 10},
+    {"__FLT16_DENORM_MIN__", 20, 1390944325u, true, 1, 285, 0, 285, 5},
+    {"__FLT128_EPSILON__", 18, 80101915u, true, 1, 290, 0, 290, 5},
+    {"__FLT64X_NORM_MAX__", 19, 2493787025u, true, 1, 295, 0, 295, 5},
+    {"__SIZEOF_POINTER__", 18, 3466682139u, true, 1, 300, 0, 300, 1},
+    {"__LP64__", 8, 1337661347u, true, 1, 301, 0, 301, 1},
+    {"__DBL_HAS_QUIET_NAN__", 21, 2909789775u, true, 1, 302, 0, 302, 1},
+    {"__FLT32X_EPSILON__", 18, 1453191321u, true, 1, 303, 0, 303, 5},
+    {"__DECIMAL_BID_FORMAT__", 22, 1042901006u, true, 1, 308, 0, 308, 1},
+    {"__FLT64_MIN_EXP__", 17, 759123052u, true, 1, 309, 0, 309, 4},
+    {"__FLT64_MIN_10_EXP__", 20, 2233435104u, true, 1, 313, 0, 313, 4},
+    {"__FLT16_MIN_10_EXP__", 20, 4109227719u, true, 1, 317, 0, 317, 4},
+    {"__FLT64X_DECIMAL_DIG__", 22, 2820755742u, true, 1, 321, 0, 321, 1},
+    {"__DEC128_MIN__", 14, 4272443439u, true, 1, 322, 0, 322, 3},
+    {"__REGISTER_PREFIX__", 19, 2035172781u, true, 1, 325, 0, 325, 0},
+    {"__UINT16_MAX__", 14, 2921419031u, true, 1, 325, 0, 325, 1},
+    {"__DBL_HAS_DENORM__", 18, 2942188654u, true, 1, 326, 0, 326, 1},
+    {"__LDBL_HAS_INFINITY__", 21, 3001188161u, true, 1, 327, 0, 327, 1},
+    {"__FLT32_MIN__", 13, 2319045319u, true, 1, 328, 0, 328, 5},
+    {"__UINT8_TYPE__", 14, 1607327496u, true, 1, 333, 0, 333, 3},
+    {"__FLT_DIG__", 11, 1162693926u, true, 1, 336, 0, 336, 1},
+    {"__NO_INLINE__", 13, 3723102554u, true, 1, 337, 0, 337, 1},
+    {"__DEC_EVAL_METHOD__", 19, 442952882u, true, 1, 338, 0, 338, 1},
+    {"__DEC128_MAX__", 14, 213647853u, true, 1, 339, 0, 339, 3},
+    {"__FLT_MANT_DIG__", 16, 1960471161u, true, 1, 342, 0, 342, 1},
+    {"__LDBL_DECIMAL_DIG__", 20, 3740946884u, true, 1, 343, 0, 343, 1},
+    {"__VERSION__", 11, 2504110331u, true, 1, 344, 0, 344, 1},
+    {"__UINT64_C", 10, 1543193443u, true, 2, 345, 1, 346, 6},
+    {"_STDC_PREDEF_H", 14, 2090017798u, true, 1, 352, 0, 352, 1},
+    {"__INT_LEAST32_MAX__", 19, 3142630608u, true, 1, 353, 0, 353, 1},
+    {"__GCC_ATOMIC_INT_LOCK_FREE", 26, 594089341u, true, 1, 354, 0, 354, 1},
+    {"__FLT128_MAX_EXP__", 18, 2495552803u, true, 1, 355, 0, 355, 1},
+    {"__FLT32_MANT_DIG__", 18, 158381758u, true, 1, 356, 0, 356, 1},
+    {"__FLOAT_WORD_ORDER__", 20, 3007148181u, true, 1, 357, 0, 357, 1},
+    {"__FLT32X_MIN_EXP__", 18, 4217121847u, true, 1, 358, 0, 358, 4},
+    {"__STDC_IEC_60559_COMPLEX__", 26, 2181336460u, true, 1, 362, 0, 362, 1},
+    {"__FLT128_HAS_DENORM__", 21, 786599403u, true, 1, 363, 0, 363, 1},
+    {"__FLT32_DECIMAL_DIG__", 21, 3644411991u, true, 1, 364, 0, 364, 1},
+    {"__FLT128_DIG__", 14, 1669616537u, true, 1, 365, 0, 365, 1},
+    {"__INT32_C", 9, 560572015u, true, 2, 366, 1, 367, 1},
+    {"__DEC64_EPSILON__", 17, 2289039428u, true, 1, 368, 0, 368, 3},
+    {"__ORDER_PDP_ENDIAN__", 20, 1765113446u, true, 1, 371, 0, 371, 1},
+    {"__DEC128_MIN_EXP__", 18, 3556902939u, true, 1, 372, 0, 372, 4},
+    {"__INT_FAST32_TYPE__", 19, 1072743761u, true, 1, 376, 0, 376, 3},
+    {"__UINT_LEAST16_TYPE__", 21, 2888821489u, true, 1, 379, 0, 379, 5},
+    {"unix", 4, 3702851363u, true, 1, 384, 0, 384, 1},
+    {"__SIZE_TYPE__", 13, 3914947021u, true, 1, 385, 0, 385, 5},
+    {"__UINT64_MAX__", 14, 2343528650u, true, 1, 390, 0, 390, 1},
+    {"__FLT_IS_IEC_60559__", 20, 542612850u, true, 1, 391, 0, 391, 1},
+    {"__GNUC_WIDE_EXECUTION_CHARSET_NAME", 34, 1069108544u, true, 1, 392, 0, 392, 1},
+    {"__FLT64X_DIG__", 14, 748250966u, true, 1, 393, 0, 393, 1},
+    {"__INT8_TYPE__", 13, 4160046031u, true, 1, 394, 0, 394, 3},
+    {"__ELF__", 7, 3501085866u, true, 1, 397, 0, 397, 1},
+    {"__GCC_ASM_FLAG_OUTPUTS__", 24, 3602060326u, true, 1, 398, 0, 398, 1},
+    {"__UINT32_TYPE__", 15, 2829098201u, true, 1, 399, 0, 399, 3},
+    {"__FLT_RADIX__", 13, 2733496688u, true, 1, 402, 0, 402, 1},
+    {"__INT_LEAST16_TYPE__", 20, 3822633812u, true, 1, 403, 0, 403, 3},
+    {"__LDBL_EPSILON__", 16, 739660822u, true, 1, 406, 0, 406, 5},
+    {"__UINTMAX_C", 11, 1995515173u, true, 2, 411, 1, 412, 6},
+    {"__SSE_MATH__", 12, 4287314009u, true, 1, 418, 0, 418, 1},
+    {"__k8", 4, 1569350176u, true, 1, 419, 0, 419, 1},
+    {"__FLT32X_MIN__", 14, 626098619u, true, 1, 420, 0, 420, 5},
+    {"__SIG_ATOMIC_MAX__", 18, 1653860547u, true, 1, 425, 0, 425, 1},
+    {"__GCC_ATOMIC_WCHAR_T_LOCK_FREE", 30, 2859538230u, true, 1, 426, 0, 426, 1},
+    {"__USER_LABEL_PREFIX__", 21, 1010281048u, true, 1, 427, 0, 427, 0},
+    {"__STDC_IEC_60559_BFP__", 22, 1110565488u, true, 1, 427, 0, 427, 1},
+    {"__SIZEOF_PTRDIFF_T__", 20, 2248466620u, true, 1, 428, 0, 428, 1},
+    {"__LDBL_DIG__", 12, 2835903404u, true, 1, 429, 0, 429, 1},
+    {"__FLT64_IS_IEC_60559__", 22, 9202412u, true, 1, 430, 0, 430, 1},
+    {"__x86_64__", 10, 2763576128u, true, 1, 431, 0, 431, 1},
+    {"__FLT16_IS_IEC_60559__", 22, 3838920691u, true, 1, 432, 0, 432, 1},
+    {"__FLT16_MAX_EXP__", 17, 2324038663u, true, 1, 433, 0, 433, 1},
+    {"__DEC32_SUBNORMAL_MIN__", 23, 301930355u, true, 1, 434, 0, 434, 5},
+    {"__INT_FAST16_MAX__", 18, 1642351247u, true, 1, 439, 0, 439, 1},
+    {"__GCC_CONSTRUCTIVE_SIZE", 23, 1416343378u, true, 1, 440, 0, 440, 1},
+    {"__FLT64_DIG__", 13, 1178008876u, true, 1, 441, 0, 441, 1},
+    {"__UINT_FAST32_MAX__", 19, 1944268288u, true, 1, 442, 0, 442, 1},
+    {"__UINT_LEAST64_TYPE__", 21, 2668805774u, true, 1, 443, 0, 443, 5},
+    {"__FLT16_EPSILON__", 17, 1370898279u, true, 1, 448, 0, 448, 5},
+    {"__FLT_HAS_QUIET_NAN__", 21, 130055403u, true, 1, 453, 0, 453, 1},
+    {"__FLT_MAX_10_EXP__", 18, 2797526316u, true, 1, 454, 0, 454, 1},
+    {"__LONG_MAX__", 12, 1518319758u, true, 1, 455, 0, 455, 1},
+    {"__FLT64X_HAS_DENORM__", 21, 791222874u, true, 1, 456, 0, 456, 1},
+    {"__DEC128_SUBNORMAL_MIN__", 24, 3615158601u, true, 1, 457, 0, 457, 5},
+    {"__FLT_HAS_INFINITY__", 20, 2413469215u, true, 1, 462, 0, 462, 1},
+    {"__GNUC_EXECUTION_CHARSET_NAME", 29, 1406094862u, true, 1, 463, 0, 463, 1},
+    {"__UINT_FAST16_TYPE__", 20, 605237796u, true, 1, 464, 0, 464, 5},
+    {"__DEC64_MAX__", 13, 4192533824u, true, 1, 469, 0, 469, 3},
+    {"__INT_FAST32_WIDTH__", 20, 2489198779u, true, 1, 472, 0, 472, 1},
+    {"__CHAR16_TYPE__", 15, 758365275u, true, 1, 473, 0, 473, 5},
+    {"__PRAGMA_REDEFINE_EXTNAME", 25, 176918921u, true, 1, 478, 0, 478, 1},
+    {"__SIZE_WIDTH__", 14, 535716487u, true, 1, 479, 0, 479, 1},
+    {"__SEG_FS", 8, 3924939806u, true, 1, 480, 0, 480, 1},
+    {"__INT_LEAST16_MAX__", 19, 3256462150u, true, 1, 481, 0, 481, 1},
+    {"__FLT16_NORM_MAX__", 18, 1836066224u, true, 1, 482, 0, 482, 5},
+    {"__DEC64_MANT_DIG__", 18, 2345522413u, true, 1, 487, 0, 487, 1},
+    {"__INT64_MAX__", 13, 2293310425u, true, 1, 488, 0, 488, 1},
+    {"__FLT32_DENORM_MIN__", 20, 2360660399u, true, 1, 489, 0, 489, 5},
+    {"__SIG_ATOMIC_WIDTH__", 20, 4009370649u, true, 1, 494, 0, 494, 1},
+    {"__INT_LEAST64_TYPE__", 20, 2380520531u, true, 1, 495, 0, 495, 3},
+    {"__INT16_TYPE__", 14, 160824946u, true, 1, 498, 0, 498, 3},
+    {"__INT_LEAST8_TYPE__", 19, 3491551057u, true, 1, 501, 0, 501, 3},
+    {"__FLT16_MAX__", 13, 2685932459u, true, 1, 504, 0, 504, 5},
+    {"__STDC_VERSION__", 16, 2698393612u, true, 1, 509, 0, 509, 1},
+    {"__SIZEOF_INT__", 14, 473645931u, true, 1, 510, 0, 510, 1},
+    {"__DEC32_MAX_EXP__", 17, 485535391u, true, 1, 511, 0, 511, 1},
+    {"__INT_FAST8_MAX__", 17, 1923643010u, true, 1, 512, 0, 512, 1},
+    {"__FLT128_MAX__", 14, 2980658423u, true, 1, 513, 0, 513, 5},
+    {"__INTPTR_MAX__", 14, 4159411857u, true, 1, 518, 0, 518, 1},
+    {"linux", 5, 3971716381u, true, 1, 519, 0, 519, 1},
+    {"__FLT64_HAS_QUIET_NAN__", 23, 954826825u, true, 1, 520, 0, 520, 1},
+    {"__FLT32_MIN_10_EXP__", 20, 2377542889u, true, 1, 521, 0, 521, 4},
+    {"__FLT32X_DIG__", 14, 1765398911u, true, 1, 525, 0, 525, 1},
+    {"__PTRDIFF_WIDTH__", 17, 1590620313u, true, 1, 526, 0, 526, 1},
+    {"__LDBL_MANT_DIG__", 17, 4061213875u, true, 1, 527, 0, 527, 1},
+    {"__FLT64_HAS_INFINITY__", 22, 4180607937u, true, 1, 528, 0, 528, 1},
+    {"__FLT64X_MAX__", 14, 3578201852u, true, 1, 529, 0, 529, 5},
+    {"__FLT16_HAS_INFINITY__", 22, 4194018682u, true, 1, 534, 0, 534, 1},
+    {"__SIG_ATOMIC_MIN__", 18, 3079583401u, true, 1, 535, 0, 535, 8},
+    {"__code_model_small__", 20, 1036027622u, true, 1, 543, 0, 543, 1},
+    {"__GCC_ATOMIC_LONG_LOCK_FREE", 27, 2037271140u, true, 1, 544, 0, 544, 1},
+    {"__DEC32_MANT_DIG__", 18, 3550870764u, true, 1, 545, 0, 545, 1},
+    {"__FLT16_MANT_DIG__", 18, 3866786468u, true, 1, 546, 0, 546, 1},
+    {"__k8__", 6, 3031469878u, true, 1, 547, 0, 547, 1},
+    {"__INTPTR_TYPE__", 15, 1657988129u, true, 1, 548, 0, 548, 3},
+    {"__UINT16_TYPE__", 15, 3986372043u, true, 1, 551, 0, 551, 5},
+    {"__WCHAR_TYPE__", 14, 1640591499u, true, 1, 556, 0, 556, 1},
+    {"__pic__", 7, 2549905559u, true, 1, 557, 0, 557, 1},
+    {"__UINTPTR_MAX__", 15, 3260126460u, true, 1, 558, 0, 558, 1},
+    {"__INT_FAST64_WIDTH__", 20, 1533685932u, true, 1, 559, 0, 559, 1},
+    {"__INT_FAST64_MAX__", 18, 138141410u, true, 1, 560, 0, 560, 1},
+    {"__GCC_ATOMIC_TEST_AND_SET_TRUEVAL", 33, 465210374u, true, 1, 561, 0, 561, 1},
+    {"__FLT_NORM_MAX__", 16, 3707289121u, true, 1, 562, 0, 562, 5},
+    {"__FLT32_HAS_INFINITY__", 22, 75962492u, true, 1, 567, 0, 567, 1},
+    {"__FLT64X_MAX_EXP__", 18, 991537752u, true, 1, 568, 0, 568, 1},
+    {"__UINT_FAST64_TYPE__", 20, 120499235u, true, 1, 569, 0, 569, 5},
+    {"__INT_MAX__", 11, 1593492123u, true, 1, 574, 0, 574, 1},
+    {"__linux__", 9, 1385684897u, true, 1, 575, 0, 575, 1},
+    {"__INT64_TYPE__", 14, 7846505u, true, 1, 576, 0, 576, 3},
+    {"__FLT_MAX_EXP__", 15, 2025528744u, true, 1, 579, 0, 579, 1},
+    {"__ORDER_BIG_ENDIAN__", 20, 1560990560u, true, 1, 580, 0, 580, 1},
+    {"__DBL_MANT_DIG__", 16, 4151837901u, true, 1, 581, 0, 581, 1},
+    {"__SIZEOF_FLOAT128__", 19, 2018849237u, true, 1, 582, 0, 582, 1},
+    {"__INT_LEAST64_MAX__", 19, 1222728671u, true, 1, 583, 0, 583, 1},
+    {"__GCC_ATOMIC_CHAR16_T_LOCK_FREE", 31, 1455801902u, true, 1, 584, 0, 584, 1},
+    {"__DEC64_MIN__", 13, 2704876966u, true, 1, 585, 0, 585, 3},
+    {"__WINT_TYPE__", 13, 1572691604u, true, 1, 588, 0, 588, 3},
+    {"__UINT_LEAST32_TYPE__", 21, 950770699u, true, 1, 591, 0, 591, 3},
+    {"__SIZEOF_SHORT__", 16, 374457460u, true, 1, 594, 0, 594, 1},
+    {"__FLT32_NORM_MAX__", 18, 3289491838u, true, 1, 595, 0, 595, 5},
+    {"__SSE__", 7, 3695326442u, true, 1, 600, 0, 600, 1},
+    {"__LDBL_MIN_EXP__", 16, 2807147244u, true, 1, 601, 0, 601, 4},
+    {"__FLT64_MAX__", 13, 1944026774u, true, 1, 605, 0, 605, 5},
+    {"__amd64__", 9, 2974566299u, true, 1, 610, 0, 610, 1},
+    {"__WINT_WIDTH__", 14, 2785936688u, true, 1, 611, 0, 611, 1},
+    {"__INT_LEAST8_MAX__", 18, 1008400225u, true, 1, 612, 0, 612, 1},
+    {"__INT_LEAST64_WIDTH__", 21, 3914759413u, true, 1, 613, 0, 613, 1},
+    {"__LDBL_MAX_EXP__", 16, 579901574u, true, 1, 614, 0, 614, 1},
+    {"__FLT32X_MAX_10_EXP__", 21, 1781698455u, true, 1, 615, 0, 615, 1},
+    {"__SIZEOF_INT128__", 17, 1439273860u, true, 1, 616, 0, 616, 1},
+    {"__FLT16_MIN__", 13, 418487617u, true, 1, 617, 0, 617, 5},
+    {"__FLT64X_IS_IEC_60559__", 23, 1469442306u, true, 1, 622, 0, 622, 1},
+    {"__LDBL_MAX_10_EXP__", 19, 3501341570u, true, 1, 623, 0, 623, 1},
+    {"__ATOMIC_RELAXED", 16, 2796825714u, true, 1, 624, 0, 624, 1},
+    {"__DBL_EPSILON__", 15, 3846213092u, true, 1, 625, 0, 625, 10},
+    {"__FLT128_MIN__", 14, 2553473317u, true, 1, 635, 0, 635, 5},
+    {"_LP64", 5, 3335130392u, true, 1, 640, 0, 640, 1},
+    {"__UINT8_C", 9, 7142819u, true, 2, 641, 1, 642, 1},
+    {"__FLT64_MAX_EXP__", 17, 2826844678u, true, 1, 643, 0, 643, 1},
+    {"__INT_LEAST32_TYPE__", 20, 2507107482u, true, 1, 644, 0, 644, 1},
+    {"__SIZEOF_WCHAR_T__", 18, 1300043024u, true, 1, 645, 0, 645, 1},
+    {"__UINT64_TYPE__", 15, 174813128u, true, 1, 646, 0, 646, 5},
+    {"__GNUC_PATCHLEVEL__", 19, 4203620997u, true, 1, 651, 0, 651, 1},
+    {"__FLT128_NORM_MAX__", 19, 2432670916u, true, 1, 652, 0, 652, 5},
+    {"__FLT64_NORM_MAX__", 18, 4221536527u, true, 1, 657, 0, 657, 5},
+    {"__FLT128_HAS_QUIET_NAN__", 24, 355860204u, true, 1, 662, 0, 662, 1},
+    {"__INTMAX_MAX__", 14, 1302751189u, true, 1, 663, 0, 663, 1},
+    {"__INT_FAST8_TYPE__", 18, 2013888512u, true, 1, 664, 0, 664, 3},
+    {"__FLT64X_MIN__", 14, 3720156490u, true, 1, 667, 0, 667, 5},
+    {"__GNUC_STDC_INLINE__", 20, 1743705861u, true, 1, 672, 0, 672, 1},
+    {"__FLT64_HAS_DENORM__", 20, 1656759108u, true, 1, 673, 0, 673, 1},
+    {"__FLT32_EPSILON__", 17, 266207701u, true, 1, 674, 0, 674, 5},
+    {"__FLT16_HAS_DENORM__", 20, 2382485727u, true, 1, 679, 0, 679, 1},
+    {"__DBL_DECIMAL_DIG__", 19, 781760626u, true, 1, 680, 0, 680, 1},
+    {"__STDC_UTF_32__", 15, 667718679u, true, 1, 681, 0, 681, 1},
+    {"__INT_FAST8_WIDTH__", 19, 2903261260u, true, 1, 682, 0, 682, 1},
+    {"__FXSR__", 8, 2841770758u, true, 1, 683, 0, 683, 1},
+    {"__FLT32X_MAX__", 14, 958691249u, true, 1, 684, 0, 684, 5},
+    {"__DBL_NORM_MAX__", 16, 2887147053u, true, 1, 689, 0, 689, 10},
+    {"__BYTE_ORDER__", 14, 2592042648u, true, 1, 699, 0, 699, 1},
+    {"__GCC_DESTRUCTIVE_SIZE", 22, 1420468003u, true, 1, 700, 0, 700, 1},
+    {"__INTMAX_WIDTH__", 16, 642689599u, true, 1, 701, 0, 701, 1},
+    {"__UINT32_C", 10, 213949904u, true, 2, 702, 1, 703, 6},
+    {"__FLT_DENORM_MIN__", 18, 3246279356u, true, 1, 709, 0, 709, 5},
+    {"__INT8_MAX__", 12, 2530572395u, true, 1, 714, 0, 714, 1},
+    {"__LONG_WIDTH__", 14, 2704458680u, true, 1, 715, 0, 715, 1},
+    {"__PIC__", 7, 2509695415u, true, 1, 716, 0, 716, 1},
+    {"__UINT_FAST32_TYPE__", 20, 2403584618u, true, 1, 717, 0, 717, 5},
+    {"__FLT32X_NORM_MAX__", 19, 3378411026u, true, 1, 722, 0, 722, 5},
+    {"__CHAR32_TYPE__", 15, 2255063657u, true, 1, 727, 0, 727, 3},
+    {"__FLT_MAX__", 11, 436148012u, true, 1, 730, 0, 730, 5},
+    {"__SSE2__", 8, 976166552u, true, 1, 735, 0, 735, 1},
+    {"__INT32_TYPE__", 14, 407203212u, true, 1, 736, 0, 736, 1},
+    {"__SIZEOF_DOUBLE__", 17, 2890568743u, true, 1, 737, 0, 737, 1},
+    {"__FLT_MIN_10_EXP__", 18, 2584063814u, true, 1, 738, 0, 738, 4},
+    {"__FLT64_MIN__", 13, 3431580464u, true, 1, 742, 0, 742, 5},
+    {"__INT_LEAST32_WIDTH__", 21, 519591246u, true, 1, 747, 0, 747, 1},
+    {"__INTMAX_TYPE__", 15, 1075551493u, true, 1, 748, 0, 748, 3},
+    {"__DEC128_MAX_EXP__", 18, 3735101789u, true, 1, 751, 0, 751, 1},
+    {"__FLT32X_HAS_QUIET_NAN__", 24, 3796077626u, true, 1, 752, 0, 752, 1},
+    {"__ATOMIC_CONSUME", 16, 3666241339u, true, 1, 753, 0, 753, 1},
+    {"__GNUC_MINOR__", 14, 3356188154u, true, 1, 754, 0, 754, 1},
+    {"__INT_FAST16_WIDTH__", 20, 1332595333u, true, 1, 755, 0, 755, 1},
+    {"__UINTMAX_MAX__", 15, 708093368u, true, 1, 756, 0, 756, 1},
+    {"__PIE__", 7, 1846122381u, true, 1, 757, 0, 757, 1},
+    {"__FLT32X_DENORM_MIN__", 21, 4037290891u, true, 1, 758, 0, 758, 5},
+    {"__DBL_MAX_10_EXP__", 18, 1915701680u, true, 1, 763, 0, 763, 1},
+    {"__LDBL_DENORM_MIN__", 19, 2598664350u, true, 1, 764, 0, 764, 5},
+    {"__INT16_C", 9, 3428864437u, true, 2, 769, 1, 770, 1},
+    {"__STDC__", 8, 2209041023u, true, 1, 771, 0, 771, 1},
+    {"__PTRDIFF_TYPE__", 16, 231779527u, true, 1, 772, 0, 772, 3},
+    {"__ATOMIC_SEQ_CST", 16, 1544394475u, true, 1, 775, 0, 775, 1},
+    {"__FLT32X_MIN_10_EXP__", 21, 1305880381u, true, 1, 776, 0, 776, 4},
+    {"__UINTPTR_TYPE__", 16, 4125570886u, true, 1, 780, 0, 780, 5},
+    {"__DEC64_SUBNORMAL_MIN__", 23, 1848860280u, true, 1, 785, 0, 785, 5},
+    {"__DEC128_MANT_DIG__", 19, 1026906022u, true, 1, 790, 0, 790, 1},
+    {"__LDBL_MIN_10_EXP__", 19, 127185760u, true, 1, 791, 0, 791, 4},
+    {"__SIZEOF_LONG_LONG__", 20, 2136184575u, true, 1, 795, 0, 795, 1},
+    {"__FLT128_DECIMAL_DIG__", 22, 800558485u, true, 1, 796, 0, 796, 1},
+    {"__GCC_ATOMIC_LLONG_LOCK_FREE", 28, 1831700510u, true, 1, 797, 0, 797, 1},
+    {"__FLT32_HAS_QUIET_NAN__", 23, 385140894u, true, 1, 798, 0, 798, 1},
+    {"__FLT_DECIMAL_DIG__", 19, 1314189518u, true, 1, 799, 0, 799, 1},
+    {"__UINT_FAST16_MAX__", 19, 3995577462u, true, 1, 800, 0, 800, 1},
+    {"__LDBL_NORM_MAX__", 17, 2794081423u, true, 1, 801, 0, 801, 5},
+    {"__GCC_ATOMIC_SHORT_LOCK_FREE", 28, 863155246u, true, 1, 806, 0, 806, 1},
+    {"__UINT_FAST8_TYPE__", 19, 3131263841u, true, 1, 807, 0, 807, 3},
+    {"__ATOMIC_ACQ_REL", 16, 2542617526u, true, 1, 810, 0, 810, 1},
+    {"__ATOMIC_RELEASE", 16, 1699194456u, true, 1, 811, 0, 811, 1},
+};
+
+// Index + 1 of predef_macros by hash (linear probing), 0 if empty
+static unsigned short predef_index[PREDEF_INDEX_SIZE] = {
+    330, 0, 112, 0, 0, 0, 181, 224, 111, 284, 73, 300, 117, 256, 161, 0,
+    0, 0, 0, 0, 0, 0, 210, 337, 0, 251, 0, 195, 50, 139, 245, 382,
+    0, 277, 0, 288, 0, 0, 206, 356, 0, 0, 0, 0, 0, 0, 387, 166,
+    0, 0, 0, 0, 0, 108, 0, 187, 0, 0, 362, 0, 0, 0, 0, 0,
+    0, 66, 0, 0, 193, 154, 0, 0, 0, 263, 0, 0, 338, 131, 0, 0,
+    0, 0, 97, 252, 0, 0, 8, 190, 32, 212, 0, 242, 0, 0, 0, 0,
+    0, 0, 0, 0, 16, 47, 0, 0, 0, 0, 0, 347, 162, 0, 15, 169,
+    10, 0, 316, 336, 301, 6, 385, 0, 74, 0, 0, 0, 286, 0, 0, 0,
+    0, 0, 0, 0, 0, 3, 21, 118, 310, 94, 0, 279, 0, 133, 234, 386,
+    0, 91, 0, 75, 0, 186, 0, 280, 0, 160, 266, 68, 322, 0, 370, 383,
+    136, 103, 151, 0, 0, 0, 0, 0, 0, 119, 205, 0, 282, 0, 0, 121,
+    0, 39, 175, 267, 0, 0, 0, 0, 0, 0, 0, 241, 219, 0, 0, 0,
+    0, 0, 0, 215, 326, 0, 0, 373, 0, 0, 200, 0, 0, 294, 384, 0,
+    182, 0, 77, 0, 0, 11, 0, 0, 0, 207, 0, 0, 0, 0, 0, 335,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 264, 303, 232, 141, 248, 274, 127,
+    67, 125, 0, 0, 0, 309, 0, 260, 0, 12, 0, 179, 281, 0, 5, 0,
+    0, 0, 314, 0, 53, 360, 0, 0, 0, 0, 0, 0, 0, 0, 0, 327,
+    323, 0, 0, 0, 0, 0, 49, 101, 168, 319, 150, 0, 0, 262, 152, 143,
+    165, 0, 0, 184, 0, 211, 173, 318, 149, 0, 0, 0, 228, 233, 0, 0,
+    307, 0, 0, 104, 0, 0, 0, 0, 0, 48, 54, 0, 0, 0, 0, 0,
+    202, 240, 313, 137, 0, 89, 153, 0, 92, 236, 331, 120, 0, 113, 359, 0,
+    0, 196, 0, 0, 0, 0, 0, 0, 0, 0, 174, 0, 0, 361, 99, 0,
+    0, 115, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    208, 0, 201, 0, 0, 132, 0, 0, 0, 0, 270, 40, 0, 183, 128, 265,
+    87, 302, 0, 0, 17, 0, 0, 0, 0, 134, 243, 0, 188, 355, 0, 0,
+    0, 0, 0, 0, 0, 381, 98, 0, 0, 0, 13, 0, 0, 0, 0, 0,
+    4, 71, 0, 124, 320, 81, 298, 2, 292, 0, 0, 0, 0, 167, 0, 250,
+    82, 247, 369, 0, 0, 371, 0, 349, 366, 0, 0, 214, 0, 0, 0, 0,
+    64, 0, 0, 0, 178, 0, 0, 0, 0, 0, 0, 278, 0, 199, 0, 0,
+    345, 0, 0, 0, 0, 144, 295, 334, 0, 0, 0, 0, 0, 0, 0, 100,
+    114, 0, 0, 0, 317, 0, 0, 0, 0, 129, 0, 189, 0, 176, 0, 0,
+    0, 0, 0, 0, 0, 18, 0, 0, 0, 0, 364, 0, 0, 0, 0, 0,
+    229, 0, 0, 0, 0, 0, 321, 0, 79, 0, 0, 0, 0, 0, 238, 35,
+    0, 0, 351, 0, 0, 0, 0, 0, 0, 0, 0, 155, 0, 0, 0, 148,
+    213, 237, 285, 0, 239, 0, 0, 0, 0, 0, 23, 0, 0, 341, 297, 0,
+    30, 0, 0, 0, 27, 0, 0, 0, 0, 0, 0, 0, 0, 0, 29, 88,
+    344, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 159,
+    0, 0, 0, 0, 0, 83, 0, 122, 217, 287, 147, 235, 390, 0, 0, 0,
+    110, 0, 0, 0, 273, 0, 194, 0, 0, 291, 350, 352, 51, 0, 0, 192,
+    218, 0, 146, 253, 0, 0, 0, 135, 377, 177, 0, 0, 0, 0, 0, 372,
+    0, 0, 259, 0, 0, 70, 145, 244, 325, 365, 0, 0, 86, 93, 230, 226,
+    0, 20, 261, 22, 299, 59, 63, 305, 342, 354, 0, 289, 0, 0, 0, 14,
+    62, 258, 0, 0, 106, 275, 0, 0, 0, 61, 271, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 46, 130, 346, 185, 0,
+    0, 9, 0, 0, 126, 0, 0, 164, 171, 102, 0, 0, 0, 0, 0, 0,
+    69, 42, 37, 0, 0, 0, 0, 0, 0, 0, 0, 52, 0, 0, 0, 0,
+    0, 55, 283, 0, 0, 0, 272, 0, 0, 0, 0, 374, 221, 107, 45, 304,
+    328, 197, 0, 80, 0, 0, 0, 0, 0, 0, 0, 0, 269, 0, 0, 58,
+    380, 0, 0, 85, 0, 332, 84, 339, 172, 0, 19, 0, 0, 0, 26, 0,
+    0, 0, 0, 31, 0, 0, 0, 0, 0, 0, 0, 157, 44, 24, 60, 0,
+    0, 0, 56, 198, 343, 0, 0, 0, 0, 0, 142, 0, 353, 0, 0, 0,
+    358, 0, 0, 0, 0, 0, 76, 216, 276, 0, 0, 43, 90, 363, 375, 0,
+    222, 170, 0, 0, 33, 333, 246, 36, 357, 376, 0, 65, 0, 0, 0, 0,
+    28, 254, 227, 0, 209, 0, 203, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    293, 308, 379, 180, 388, 0, 0, 231, 0, 0, 7, 257, 0, 0, 0, 0,
+    0, 72, 0, 225, 0, 123, 0, 0, 0, 0, 0, 78, 0, 138, 0, 0,
+    0, 0, 315, 0, 312, 0, 0, 0, 0, 0, 0, 368, 0, 367, 0, 0,
+    0, 156, 95, 57, 0, 0, 0, 311, 0, 41, 191, 306, 0, 0, 0, 0,
+    0, 290, 0, 158, 0, 0, 378, 0, 0, 0, 0, 255, 34, 220, 0, 0,
+    0, 340, 0, 0, 0, 0, 389, 0, 348, 0, 0, 1, 0, 0, 0, 140,
+    0, 268, 0, 0, 0, 0, 0, 0, 324, 105, 0, 0, 0, 0, 0, 204,
+    0, 0, 0, 0, 0, 329, 0, 25, 0, 249, 0, 0, 0, 0, 0, 296,
+    163, 0, 0, 0, 0, 0, 0, 0, 0, 0, 109, 96, 0, 0, 0, 0,
+    0, 0, 0, 223, 0, 0, 0, 0, 0, 0, 0, 116, 38, 0, 0, 0,
+};
+
+#endif // PREDEF_TABLE_H
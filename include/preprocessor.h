@@ -1,14 +1,28 @@
 #ifndef PREPROCESSOR_C_COMPILER
 #define PREPROCESSOR_C_COMPILER
 
+#include "header.h"
 #include "tokenizer.h"
 #include "vector.h"
 
+// Include guard detection of the current file
+typedef enum
+{
+  GUARD_START,        // Nothing but whitespace so far
+  GUARD_IN_GROUP,     // In the #ifndef group of the candidate guard
+  GUARD_AFTER_GROUP,  // After its #endif, nothing but whitespace so far
+  GUARD_NONE,         // Not guarded as a whole
+} guard_state;
+
 extern bool gcc_compatible;
 extern Vector *Conditional_Inclusion_List;
+extern guard_state File_Guard_State;
+extern Atom *File_Guard;
 void line_count();
+Token *token_next_lazy(Token *token);
 Token *token_next_not_ignorable(Token *token);
 Token *token_next_not_ignorable_void(Token *token);
+void skip_group(Token *linebreak);
 
 void token_void(Token *token);
 Token *preprocess(char *input, char *end, char *file_name, Token *token);
@@ -5,9 +5,12 @@
 #include "../test/compiler_header.h"
 #else
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #endif
 
+#include "atom.h"
+
 typedef enum
 {
   TK_RESERVED,   // Symbol
@@ -28,22 +31,99 @@ typedef enum
       "TK_IDENT", "TK_STRING", "TK_CHAR", "TK_EOF"
 extern const char *tokenkindlist[TK_END];
 
+// Keywords. They are registered in the atom table by init_keywords(), so
+// the tokenizer classifies an identifier without any extra lookup.
+typedef enum
+{
+  KW_NONE,  // Not a keyword
+  // Type specifiers and qualifiers accepted by is_type_specifier()
+  // from KW_VOID to KW_ENUM
+  KW_VOID,
+  KW_CHAR,
+  KW_SHORT,
+  KW_INT,
+  KW_LONG,
+  KW_SIGNED,
+  KW_UNSIGNED,
+  KW_BOOL,
+  KW__BOOL,
+  KW_CONST,
+  KW_STRUCT,
+  KW_UNION,
+  KW_ENUM,
+  KW_RESTRICT,
+  KW_VOLATILE,
+  // Storage class and function specifiers
+  KW_TYPEDEF,
+  KW_EXTERN,
+  KW_STATIC,
+  KW_AUTO,
+  KW_REGISTER,
+  KW_INLINE,
+  // Statements
+  KW_IF,
+  KW_ELSE,
+  KW_SWITCH,
+  KW_CASE,
+  KW_DEFAULT,
+  KW_WHILE,
+  KW_DO,
+  KW_FOR,
+  KW_GOTO,
+  KW_CONTINUE,
+  KW_BREAK,
+  KW_RETURN,
+  // Operators
+  KW_SIZEOF,
+  KW_END,
+} Keyword;
+
+// Must be added if Keyword is added.
+#define KeywordTable                                                          \
+  "", "void", "char", "short", "int", "long", "signed", "unsigned", "bool",   \
+      "_Bool", "const", "struct", "union", "enum", "restrict", "volatile",    \
+      "typedef", "extern", "static", "auto", "register", "inline", "if",      \
+      "else", "switch", "case", "default", "while", "do", "for", "goto",      \
+      "continue", "break", "return", "sizeof"
+extern char *keywordlist[KW_END];
+
 typedef struct Token Token;
+typedef struct HideSet HideSet;
 
+// Tokens are allocated from an arena (see token_alloc()), so keep the layout
+// small: kind and len share the first 8 bytes. The hide sets of the tokens
+// made by macros are kept aside (see token_hide_set()).
 struct Token
 {
   TokenKind kind;  // Type of token
+  uint32_t len;    // Length of token
   Token *next;     // Next token
   char *str;       // Token string
-  size_t len;      // Length of token
+  Atom *atom;      // Interned str, set for TK_IDENT only
 };
 
+void init_keywords();
+Keyword token_keyword(Token *token);
+Token *peek_keyword(Keyword keyword);
+Token *consume_keyword(Keyword keyword);
+Token *expect_keyword(Keyword keyword);
+Token *token_alloc();
+Token *token_copy(Token *token);
+HideSet *token_hide_set(Token *token);
+void token_set_hide_set(Token *token, HideSet *hide_set);
+void token_hide_sets_clear();
+void token_arena_free();
 Token *tokenize_once(char *input, char **end);
-Token *tokenizer(char *input, char *end, Token *next_token);
+bool tokens_would_paste(Token *lhs, Token *rhs);
+Token *tokenizer(char *input, char *end, Token *next_token, char **rest);
+Token *tokenize_rest(char **rest, char *end, Token *next_token);
+Token *skip_conditional_group(char *input, char *end, char **rest);
 void re_tokenize(Token *token_head);
 bool at_eof();
-void fix_token_head();
-void set_token(Token *next);
+void fix_token_head(Token *head);
+void index_tokens();
+size_t get_token_position();
+void set_token_position(size_t position);
 Token *consume_token_if_next_matches(TokenKind kind, char reserved);
 Token *peek(char *op, TokenKind kind);
 Token *consume(char *op, TokenKind kind);
@@ -56,7 +136,8 @@ Token *consume_ident();
 Token *expect_ident();
 Token *consume_string();
 Token *consume_char();
-bool is_number(long long *result);
-bool consume_number(long long *value);
+bool token_number(Token *token, unsigned long long *value, uint8_t *suffix);
+bool is_number(unsigned long long *value, uint8_t *suffix);
+bool consume_number(unsigned long long *value, uint8_t *suffix);
 
 #endif  // TOKENIZER_C_COMPILER
\ No newline at end of file
@@ -59,6 +59,9 @@ typedef enum
 } TypeKind;
 
 // Struct to manage variable types
+// The types made by basic_type(), pointer_to() and array_of() are interned,
+// so two of them are the same type if and only if they are the same object.
+// Interned types are shared and must not be modified.
 struct Type
 {
   TypeKind type;
@@ -69,6 +72,9 @@ struct Type
   size_t type_num;     // Used for TYPE_STRUCT
   Vector *param_list;  // Used for TYPE_FUNC, first argument is return type,
                        // others are argument types,
+  size_t byte_size;    // Cached size_of(), 0 until known
+  size_t alignment;    // Cached align_of(), 0 until known
+  Type *next_derived;  // Next interned pointer or array in the same bucket
 };
 
 typedef struct Node Node;  // Define only to include parser.h
@@ -82,7 +88,8 @@ typedef struct
   size_t offset;
 } tag_data_list;
 
-typedef struct
+typedef struct tag_list tag_list;
+struct tag_list
 {
   enum
   {
@@ -96,13 +103,22 @@ typedef struct
   Type *type;      // type of struct, union, or enum
   size_t struct_size;       // size of the struct
   size_t struct_alignment;  // alignment of the struct
-} tag_list;
+  size_t depth;             // nest of the declaring scope, 1 is file scope
+  tag_list *shadowed;       // tag of the same name in an outer scope
+  // Hash index of the members by name, including the members of anonymous
+  // structs and unions. Built when the struct or union is defined.
+  tag_data_list **members;
+  size_t members_size;  // number of slots of members, a power of 2
+};
 
 Token *print_struct_type(size_t tag_id);
 
 bool is_type_specifier(Token *token);
 bool is_typedef(uint8_t storage_class_specifier);
 Type *alloc_type(TypeKind kind);
+Type *basic_type(TypeKind kind, bool is_signed);
+Type *pointer_to(Type *type);
+Type *array_of(Type *type, size_t size);
 Type *declaration_specifiers(uint8_t *storage_class_specifier);
 bool add_function_name(Vector *function_list, Token *name,
                        uint8_t storage_class_specifier, bool is_defined);
@@ -126,5 +142,7 @@ void init_types();
 void new_nest_type();
 void exit_nest_type();
 Vector *get_enum_struct_list();
+void write_type_namespaces();
+void read_type_namespaces();
 
 #endif
@@ -14,6 +14,7 @@
 #endif
 #include <assert.h>
 
+#include "include/analyzer.h"
 #include "include/debug.h"
 #include "include/error.h"
 #include "include/parser.h"
@@ -367,7 +368,7 @@ static IR_REG *gen_stmt(Vector *blocks, Vector *labels, IR_Blocks **irs,
       ir->mov.is_imm = true;
       ir->mov.imm_val = node->num_val;
       IR_REG *dst_reg_ptr = gen_reg();
-      dst_reg_ptr->reg_size = SIZE_DWORD;  // int
+      dst_reg_ptr->reg_size = num2OpSize(size_of_real(node->type->type));
       ir->mov.dst_reg = dst_reg_ptr;
       vector_push(dst_reg_ptr->used_list, ir);
       vector_push((*irs)->IRs, ir);
@@ -1089,8 +1090,12 @@ static IR_REG *gen_stmt(Vector *blocks, Vector *labels, IR_Blocks **irs,
         case ND_REM: ir->kind = node->type->is_signed ? IR_REM : IR_REMU; break;
         case ND_EQ: ir->kind = IR_EQ; break;
         case ND_NEQ: ir->kind = IR_NEQ; break;
-        case ND_LT: ir->kind = node->type->is_signed ? IR_LT : IR_LTU; break;
-        case ND_LTE: ir->kind = node->type->is_signed ? IR_LTE : IR_LTEU; break;
+        case ND_LT:
+          ir->kind = is_signed_comparison(node) ? IR_LT : IR_LTU;
+          break;
+        case ND_LTE:
+          ir->kind = is_signed_comparison(node) ? IR_LTE : IR_LTEU;
+          break;
         case ND_INCLUSIVE_OR: ir->kind = IR_OR; break;
         case ND_EXCLUSIVE_OR: ir->kind = IR_XOR; break;
         case ND_AND: ir->kind = IR_AND; break;
@@ -4,14 +4,26 @@
 #include "test/compiler_header.h"
 #else
 #include <stdio.h>
+#include <string.h>
 #endif
 
+#include "include/atom.h"
 #include "include/common.h"
 #include "include/debug.h"
 #include "include/error.h"
 
 void add_cfg(Vector* blocks, Vector* labels)
 {
+  // Intern the label names so that jump targets can be matched by pointer
+  for (size_t j = 1; j <= vector_size(labels); j++)
+  {
+    IR_Blocks* block_ir_label = vector_peek_at(labels, j);
+    IR* label = vector_peek_at(block_ir_label->IRs, 1);
+    if (label->kind != IR_LABEL)
+      unreachable();
+    label->label.name =
+        atom_intern(label->label.name, strlen(label->label.name))->str;
+  }
   for (size_t i = 1; i < vector_size(blocks); i++)
   {
     pr_debug2("%d", i);
@@ -23,13 +35,13 @@ void add_cfg(Vector* blocks, Vector* labels)
       case IR_JNE:
       case IR_JE:
       {
+        bottom->jmp.label =
+            atom_intern(bottom->jmp.label, strlen(bottom->jmp.label))->str;
         for (size_t j = 1; j <= vector_size(labels); j++)
         {
           IR_Blocks* block_ir_label = vector_peek_at(labels, j);
           IR* label = vector_peek_at(block_ir_label->IRs, 1);
-          if (label->kind != IR_LABEL)
-            unreachable();
-          if (!strcmp(bottom->jmp.label, label->label.name))
+          if (bottom->jmp.label == label->label.name)
             block->lhs = block_ir_label;
           vector_push(block_ir_label->parent, block);
         }
@@ -2,18 +2,24 @@
 #include "test/compiler_header.h"
 #else
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #endif
 
 #include "include/analyzer.h"
+#include "include/cache.h"
 #include "include/debug.h"
+#include "include/dependency.h"
 #include "include/error.h"
 #include "include/file.h"
 #include "include/generator.h"
+#include "include/header.h"
 #include "include/ir_generator.h"
 #include "include/ir_optimizer.h"
 #include "include/optimizer.h"
+#include "include/output.h"
 #include "include/parser.h"
+#include "include/pch.h"
 #include "include/preprocessor.h"
 #include "include/tokenizer.h"
 
@@ -21,21 +27,53 @@ bool output_preprocess;
 bool gcc_compatible;
 bool output_ir;
 bool output_mermaid;
+bool bench_tokenize;
+bool emit_pch;
+bool output_dependency;
+bool cache_stats;
+bool dependency_has_system = true;
+bool dependency_is_phony;
 uint8_t optimize_level = 1;
 
+// Returns file_name with its extension replaced by extension
+static char *replace_extension(char *file_name, char *extension)
+{
+  char *dot = strrchr(file_name, '.');
+  char *slash = strrchr(file_name, '/');
+  size_t len = dot && (!slash || dot > slash) ? (size_t)(dot - file_name)
+                                               : strlen(file_name);
+  char *new = malloc(len + strlen(extension) + 1);
+  memcpy(new, file_name, len);
+  strcpy(new + len, extension);
+  return new;
+}
+
 // Argument processing
 // -E: Execute preprocessor and output
 // -g: Import gcc predefined macros in preprocessor
-// -o: Specify output file
-// -i: Specify input file
+// -o: Specify output file ("-" writes to standard output)
+// -i: Specify input file ("-" reads standard input)
 // -I: Use standard input after this argument as input
+// -I<dir>: Add dir to the include paths
+// -isystem: Add the directory after this argument to the system include paths
 // -emit-ir: Output IR
 // -emit-mermaid: Output AST in Mermaid format
+// -emit-pch: Output the precompiled header of the input
+// -include-pch: Load the precompiled header after this argument before the
+//               input
+// -bench-tokenizer: Measure the tokenizer throughput on the input and exit
+// -MD: Write the makefile dependencies of the input while compiling
+// -MMD: Same as -MD, leaving out the headers in the system include paths
+// -MF: Write the dependencies to the file after this argument
+// -MT: Use the argument after this as it is as the target of the dependencies
+// -MP: Add an empty rule for each header to the dependencies
+// -cache-dir: Reuse the assembly generated from the same preprocessed input
+//             in the directory after this argument
+// -cache-stats: Print the hit and miss counts of the -cache-dir directory
 // -O0: non optimized
 // -O1: optimized(default)
 int main(int argc, char **argv)
 {
-  fprintf(stdout, "\e[32mc_compiler\e[37m\n");
   if (argc < 3)
     error_exit("Invalid arguments.");
 
@@ -51,6 +89,10 @@ int main(int argc, char **argv)
 
   char *input_file_name = NULL;
   char *output_file_name = NULL;
+  char *pch_file_name = NULL;
+  char *dependency_file_name = NULL;
+  char *dependency_target = NULL;
+  char *cache_dir = NULL;
   char *input = NULL;
   // Process arguments
   for (int i = 1; i < argc; i++)
@@ -65,6 +107,29 @@ int main(int argc, char **argv)
         output_ir = true;
       else if (!strcmp(argv[i], "-emit-mermaid"))
         output_mermaid = true;
+      else if (!strcmp(argv[i], "-emit-pch"))
+        emit_pch = true;
+      else if (!strcmp(argv[i], "-include-pch") && ++i < argc)
+        pch_file_name = argv[i];
+      else if (!strcmp(argv[i], "-bench-tokenizer"))
+        bench_tokenize = true;
+      else if (!strcmp(argv[i], "-MD"))
+        output_dependency = true;
+      else if (!strcmp(argv[i], "-MMD"))
+      {
+        output_dependency = true;
+        dependency_has_system = false;
+      }
+      else if (!strcmp(argv[i], "-MF") && ++i < argc)
+        dependency_file_name = argv[i];
+      else if (!strcmp(argv[i], "-MT") && ++i < argc)
+        dependency_target = argv[i];
+      else if (!strcmp(argv[i], "-MP"))
+        dependency_is_phony = true;
+      else if (!strcmp(argv[i], "-cache-dir") && ++i < argc)
+        cache_dir = argv[i];
+      else if (!strcmp(argv[i], "-cache-stats"))
+        cache_stats = true;
       else if (!strcmp(argv[i], "-O0") && !(optimize_level & 1 << 7))
         optimize_level = 0 | 1 << 7;
       else if (!strcmp(argv[i], "-O1") && !(optimize_level & 1 << 7))
@@ -78,23 +143,97 @@ int main(int argc, char **argv)
         input = argv[++i];
         break;
       }
+      else if (!strncmp(argv[i], "-I", 2))
+        header_add_include_path(argv[i] + 2, false);
+      else if (!strcmp(argv[i], "-isystem") && ++i < argc)
+        header_add_include_path(argv[i], true);
       else
         error_exit("Invalid arguments.");
     }
   }
+  if (output_file_name && !strcmp(output_file_name, "-"))
+    output_reserve_stdout();
+  fprintf(stdout, "\e[32mc_compiler\e[37m\n");
   if (input_file_name)
     input = openfile(input_file_name);
+  init_keywords();
+  if (cache_stats)
+  {
+    if (!cache_dir)
+      error_exit("-cache-stats requires -cache-dir");
+    cache_print_stats(cache_dir);
+    return 0;
+  }
+  if (input && bench_tokenize)
+  {
+    bench_tokenizer(input);
+    return 0;
+  }
   if (!input || !output_file_name || (gcc_compatible && !output_preprocess))
     error_exit("Invalid arguments.");
   pr_debug("output_file_name: %s", output_file_name);
   pr_debug("input_file_name: %s", input_file_name);
 
   init_preprocessor();
+  init_types();
+  // The preprocessed tokens of the precompiled header precede the input
+  Token *prelude = NULL;
+  bool prelude_is_parsed = false;
+  if (pch_file_name)
+  {
+    prelude = pch_read(pch_file_name, &prelude_is_parsed);
+    dependency_add(header_find(pch_file_name), pch_file_name, false);
+  }
   // Preprocessor (includes tokenizer)
   Token *token = preprocess(input, NULL, input_file_name, NULL);
+  // The parser starts after the prelude if its declarations have been loaded
+  Token *declarations = prelude_is_parsed ? token : NULL;
+  if (prelude)
+  {
+    Token *last = prelude;
+    while (last->next)
+      last = last->next;
+    last->next = token;
+    token = prelude;
+  }
+  if (!declarations)
+    declarations = token;
+  if (output_dependency)
+  {
+    // By default the dependencies of foo.s are written to foo.d
+    char *file_name =
+        strcmp(output_file_name, "-") ? output_file_name : input_file_name;
+    if ((!dependency_file_name || !dependency_target) &&
+        (!file_name || !strcmp(file_name, "-")))
+      error_exit("-MF and -MT are required when writing to standard output");
+    if (!dependency_file_name)
+      dependency_file_name = replace_extension(file_name, ".d");
+    // The target given by -MT is written as it is, as gcc does
+    bool quote_target = !dependency_target;
+    if (!dependency_target)
+      dependency_target = file_name == output_file_name
+                              ? output_file_name
+                              : replace_extension(file_name, ".o");
+    dependency_write(dependency_file_name, dependency_target, quote_target,
+                     input_file_name, dependency_is_phony,
+                     dependency_has_system);
+  }
+  if (emit_pch)
+  {
+    pch_write(token, declarations, output_file_name);
+    return 0;
+  }
   if (output_preprocess)
     preprocessed_file_writer(token, output_file_name);
-  fix_token_head();  // Adjust the token head to not be IGNORABLE or LINEBREAK
+  // Everything after the preprocessor is skipped when the same tokens have
+  // been compiled with the same options before
+  bool use_cache = cache_dir && !output_mermaid && !output_ir;
+  if (use_cache && cache_fetch(cache_dir, token, optimize_level & ~(1 << 7),
+                               output_file_name))
+    return 0;
+  fix_token_head(declarations);  // Adjust the token head to not be IGNORABLE
+                                 // or LINEBREAK
+  index_tokens();    // Build the significant token array for the parser
   // Parser
   FuncBlock *parse_result = parser();
   if (output_mermaid)
@@ -111,6 +250,7 @@ int main(int argc, char **argv)
 
   // IR generator
   IRProgram *ir_program = gen_ir(analyze_result);
+  ast_arena_free();  // The IR does not refer to the AST
   // IR optimizer
   ir_program = optimize_ir(ir_program);
 
@@ -120,7 +260,16 @@ int main(int argc, char **argv)
     return 0;
   }
   // Code generator
-  generator(ir_program, output_file_name);
+  if (use_cache)
+  {
+    generator(ir_program, cache_output_file_name());
+    cache_store(output_file_name);
+  }
+  else
+    generator(ir_program, output_file_name);
+  // The AST and the string literal list refer to tokens until code generation
+  // has finished.
+  token_arena_free();
 
   return 0;
 }
\ No newline at end of file
@@ -2,7 +2,21 @@
 
 #include <limits.h>
 
+#include "include/analyzer.h"
 #include "include/parser.h"
+#include "include/type.h"
+
+// The value of an integer constant converted to type
+static unsigned long long convert_constant(long long value, Type* type)
+{
+  size_t bits = size_of(type) * 8;
+  if (bits >= 64)
+    return value;
+  unsigned long long mask = (1ULL << bits) - 1;
+  if (type->is_signed && value & 1LL << (bits - 1))
+    return value | ~mask;
+  return value & mask;
+}
 
 static Node* constant_folding(Node* node)
 {
@@ -41,6 +55,23 @@ static Node* constant_folding(Node* node)
       long long lhs_val = node->lhs->num_val;
       long long rhs_val = node->rhs->num_val;
       long long result_val;
+      // Comparisons, divisions and right shifts of unsigned integers work on
+      // the values converted to the unsigned type
+      Type* unsigned_type = NULL;
+      if (node->kind == ND_EQ || node->kind == ND_NEQ || node->kind == ND_LT ||
+          node->kind == ND_LTE)
+      {
+        if (!is_signed_comparison(node) && is_integer_type(node->lhs->type) &&
+            is_integer_type(node->rhs->type))
+          unsigned_type =
+              implicit_type_conversion(node->lhs->type, node->rhs->type);
+      }
+      else if (is_integer_type(node->type) && !node->type->is_signed)
+        unsigned_type = node->type;
+      unsigned long long lhs_uval =
+          unsigned_type ? convert_constant(lhs_val, unsigned_type) : 0;
+      unsigned long long rhs_uval =
+          unsigned_type ? convert_constant(rhs_val, unsigned_type) : 0;
       switch (node->kind)
       {
         case ND_ADD:
@@ -64,19 +95,40 @@ static Node* constant_folding(Node* node)
         case ND_REM:
           if (rhs_val == 0)
             break;
-          result_val = lhs_val / rhs_val;
+          if (unsigned_type)
+            result_val = node->kind == ND_DIV ? lhs_uval / rhs_uval
+                                              : lhs_uval % rhs_uval;
+          else
+            result_val = node->kind == ND_DIV ? lhs_val / rhs_val
+                                              : lhs_val % rhs_val;
+          break;
+        case ND_EQ:
+          result_val =
+              unsigned_type ? lhs_uval == rhs_uval : lhs_val == rhs_val;
+          break;
+        case ND_NEQ:
+          result_val =
+              unsigned_type ? lhs_uval != rhs_uval : lhs_val != rhs_val;
+          break;
+        case ND_LT:
+          result_val = unsigned_type ? lhs_uval < rhs_uval : lhs_val < rhs_val;
+          break;
+        case ND_LTE:
+          result_val =
+              unsigned_type ? lhs_uval <= rhs_uval : lhs_val <= rhs_val;
           break;
-        case ND_EQ: result_val = lhs_val == rhs_val; break;
-        case ND_NEQ: result_val = lhs_val != rhs_val; break;
-        case ND_LT: result_val = lhs_val < rhs_val; break;
-        case ND_LTE: result_val = lhs_val <= rhs_val; break;
         case ND_LOGICAL_OR: result_val = lhs_val || rhs_val; break;
         case ND_LOGICAL_AND: result_val = lhs_val && rhs_val; break;
         case ND_INCLUSIVE_OR: result_val = lhs_val | rhs_val; break;
         case ND_EXCLUSIVE_OR: result_val = lhs_val ^ rhs_val; break;
         case ND_AND: result_val = lhs_val & rhs_val; break;
         case ND_LEFT_SHIFT: result_val = lhs_val << rhs_val; break;
-        case ND_RIGHT_SHIFT: result_val = lhs_val >> rhs_val; break;
+        case ND_RIGHT_SHIFT:
+          if (unsigned_type)
+            result_val = lhs_uval >> rhs_val;
+          else
+            result_val = lhs_val >> rhs_val;
+          break;
         default: break;
       }
       node->kind = ND_NUM;
@@ -108,6 +160,20 @@ static Node* constant_folding(Node* node)
       node->rhs = NULL;
     }
     break;
+    case ND_SIGN_EXTEND:
+    case ND_ZERO_EXTEND:
+    case ND_TRUNCATE:
+    {
+      if (node->lhs->kind != ND_NUM || !is_integer_type(node->lhs->type) ||
+          !is_integer_type(node->type))
+        break;
+      // Convert the constant to the type it is cast to
+      node->num_val = convert_constant(
+          convert_constant(node->lhs->num_val, node->lhs->type), node->type);
+      node->kind = ND_NUM;
+      node->lhs = NULL;
+    }
+    break;
     default: break;
   }
 
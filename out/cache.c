@@ -0,0 +1 @@
+int f(int a) { return a * 2; }
@@ -0,0 +1,14 @@
+    .intel_syntax noprefix
+
+    .section .data
+    .globl x
+    .type x, @object
+    .size x, 4
+x:
+    .long 4
+    .section .data
+    .globl p
+    .type p, @object
+    .size p, 8
+p:
+    .quad x
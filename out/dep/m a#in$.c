@@ -0,0 +1,3 @@
+#include <stddef.h>
+#include "sp ace#h$.h"
+int x = ONE;
@@ -0,0 +1,8 @@
+    .intel_syntax noprefix
+
+    .section .data
+    .globl x
+    .type x, @object
+    .size x, 4
+x:
+    .long 1
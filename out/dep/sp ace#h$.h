@@ -0,0 +1 @@
+#define ONE 1
@@ -0,0 +1,6 @@
+#include <stdio.h>
+extern long a; extern unsigned long b; extern long long c; extern int d, e, f, g;
+int main() {
+  printf("%ld %lu %lld %d %d %d %d\n", a, b, c, d, e, f, g);
+  return 0;
+}
@@ -0,0 +1,3 @@
+x 6
+y 10
+z 18
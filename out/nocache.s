@@ -0,0 +1,17 @@
+    .intel_syntax noprefix
+
+    .section .data
+    .globl s
+    .type s, @object
+    .size s, 8
+s:
+    .quad .LC0
+    .section .bss
+    .globl y
+    .type y, @object
+    .size y, 8
+y:
+    .zero 8
+    .section .rodata.str1.1,"aMS",@progbits,1
+.LC0:
+    .string "cache"
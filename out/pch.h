@@ -0,0 +1 @@
+static char *empty = "";
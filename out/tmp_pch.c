@@ -0,0 +1 @@
+char *full = "x";
@@ -0,0 +1,210 @@
+// ------------------------------------------------------------------------------------
+// output file writer
+// ------------------------------------------------------------------------------------
+
+#include "include/output.h"
+
+#ifdef SELF_HOST
+#include "test/compiler_header.h"
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "include/error.h"
+
+// Everything written to the output file (assembly, preprocessed source) goes
+// through this buffer and is written with a few large write() calls.
+#define OUTPUT_BUFFER_SIZE (64 * 1024)
+
+static char output_buffer[OUTPUT_BUFFER_SIZE];
+static size_t output_len;
+static int output_fd = -1;
+static int stdout_fd = 1;
+
+// Keep the standard output for the output file ("-o -").
+// The debug logs printed to stdout go to stderr from here on.
+void output_reserve_stdout()
+{
+  stdout_fd = dup(1);
+  if (stdout_fd == -1 || dup2(2, 1) == -1)
+    error_exit("cannot redirect stdout: %s", strerror(errno));
+}
+
+// Open the output file. "-" writes to the standard output.
+void output_open(char *filename)
+{
+  output_len = 0;
+  if (!strcmp(filename, "-"))
+    output_fd = stdout_fd;
+  else
+    output_fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (output_fd == -1)
+    error_exit("cannot written to file: %s", strerror(errno));
+}
+
+// Write all of iov, retrying after partial writes
+static void output_writev(struct iovec *iov, int iovcnt)
+{
+  while (iovcnt)
+  {
+    ssize_t written = writev(output_fd, iov, iovcnt);
+    if (written == -1)
+    {
+      if (errno == EINTR)
+        continue;
+      error_exit("failed to write output: %s", strerror(errno));
+    }
+    while (iovcnt && (size_t)written >= iov->iov_len)
+    {
+      written -= iov->iov_len;
+      iov++;
+      iovcnt--;
+    }
+    if (iovcnt)
+    {
+      iov->iov_base = (char *)iov->iov_base + written;
+      iov->iov_len -= written;
+    }
+  }
+}
+
+static void output_flush()
+{
+  struct iovec iov;
+  iov.iov_base = output_buffer;
+  iov.iov_len = output_len;
+  if (output_len)
+    output_writev(&iov, 1);
+  output_len = 0;
+}
+
+void output_write(char *str, size_t len)
+{
+  if (len <= OUTPUT_BUFFER_SIZE - output_len)
+  {
+    memcpy(output_buffer + output_len, str, len);
+    output_len += len;
+    return;
+  }
+  // Does not fit: write the buffer and str together
+  struct iovec iov[2];
+  iov[0].iov_base = output_buffer;
+  iov[0].iov_len = output_len;
+  iov[1].iov_base = str;
+  iov[1].iov_len = len;
+  output_writev(iov, 2);
+  output_len = 0;
+}
+
+void output_char(char c)
+{
+  if (output_len == OUTPUT_BUFFER_SIZE)
+    output_flush();
+  output_buffer[output_len++] = c;
+}
+
+void output_string(char *str)
+{
+  output_write(str, strlen(str));
+}
+
+void output_unsigned(unsigned long long value)
+{
+  char buf[20];  // digits of the largest 64-bit value
+  char *p = buf + sizeof(buf);
+  do
+  {
+    *--p = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  output_write(p, buf + sizeof(buf) - p);
+}
+
+void output_signed(long long value)
+{
+  if (value < 0)
+  {
+    output_char('-');
+    output_unsigned(-(unsigned long long)value);
+  }
+  else
+    output_unsigned(value);
+}
+
+// Formatted output supporting only the conversions used by the generator:
+// %s %.*s %c %d %ld %lld %u %lu %llu %zu %%
+void output_format(char *fmt, ...)
+{
+  va_list ap;
+  va_start(ap, fmt);
+  for (;;)
+  {
+    char *start = fmt;
+    while (*fmt && *fmt != '%')
+      fmt++;
+    if (fmt != start)
+      output_write(start, fmt - start);
+    if (!*fmt)
+      break;
+    fmt++;  // '%'
+
+    int precision = -1;
+    if (fmt[0] == '.' && fmt[1] == '*')
+    {
+      precision = va_arg(ap, int);
+      fmt += 2;
+    }
+    size_t longs = 0;
+    while (*fmt == 'l')
+    {
+      longs++;
+      fmt++;
+    }
+    bool is_size = *fmt == 'z';
+    if (is_size)
+      fmt++;
+    switch (*fmt++)
+    {
+      case 's':
+      {
+        char *str = va_arg(ap, char *);
+        output_write(str, precision < 0 ? strlen(str) : (size_t)precision);
+        break;
+      }
+      case 'c': output_char(va_arg(ap, int)); break;
+      case 'd':
+        if (longs)
+          output_signed(longs == 1 ? va_arg(ap, long) : va_arg(ap, long long));
+        else
+          output_signed(va_arg(ap, int));
+        break;
+      case 'u':
+        if (is_size)
+          output_unsigned(va_arg(ap, size_t));
+        else if (longs)
+          output_unsigned(longs == 1 ? va_arg(ap, unsigned long)
+                                     : va_arg(ap, unsigned long long));
+        else
+          output_unsigned(va_arg(ap, unsigned int));
+        break;
+      case '%': output_char('%'); break;
+      default: error_exit("unsupported output format: %s", fmt - 1);
+    }
+  }
+  va_end(ap);
+}
+
+// Write the rest of the buffer and close the output file
+void output_close()
+{
+  output_flush();
+  if (output_fd != 1)
+    close(output_fd);
+  output_fd = -1;
+}
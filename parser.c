@@ -176,9 +176,90 @@ char *mangle_goto_label(Token *token)
   return label_name;
 }
 
+// The AST is carved out of large zero-filled chunks instead of being allocated
+// one by one, and released at once by ast_arena_free() after gen_ir().
+#define AST_CHUNK_SIZE (64 * 1024)
+
+typedef struct AstChunk AstChunk;
+
+struct AstChunk
+{
+  AstChunk *next;  // Previously filled chunk
+  size_t used;     // Number of bytes handed out from this chunk
+  char data[AST_CHUNK_SIZE];
+};
+
+static AstChunk *ast_chunk;
+
+// Allocate size zero-cleared bytes from the arena
+void *ast_alloc(size_t size)
+{
+  size = (size + 7) / 8 * 8;
+  if (!ast_chunk || AST_CHUNK_SIZE - ast_chunk->used < size)
+  {
+    AstChunk *new = calloc(1, sizeof(AstChunk));
+    new->next = ast_chunk;
+    ast_chunk = new;
+  }
+  void *result = ast_chunk->data + ast_chunk->used;
+  ast_chunk->used += size;
+  return result;
+}
+
+// Release the whole AST at once
+void ast_arena_free()
+{
+  while (ast_chunk)
+  {
+    AstChunk *next = ast_chunk->next;
+    free(ast_chunk);
+    ast_chunk = next;
+  }
+}
+
+// Size of a node of the kind. Only the statements, function definitions and
+// calls, jumps and initializers use the large members of the union, so the
+// other nodes end right after node->variable, the largest of the rest. A node
+// may only change into a kind of the same or a smaller size.
+size_t node_size(NodeKind kind)
+{
+  static Node layout;
+  switch (kind)
+  {
+    case ND_FUNCDEF:
+    case ND_FUNCCALL:
+    case ND_BUILTINFUNC:
+    case ND_IF:
+    case ND_ELIF:
+    case ND_FOR:
+    case ND_WHILE:
+    case ND_DO:
+    case ND_TERNARY:
+    case ND_LOGICAL_OR:
+    case ND_LOGICAL_AND:
+    case ND_SWITCH:
+    case ND_BLOCK:
+    case ND_GOTO:
+    case ND_LABEL:
+    case ND_CASE:
+    case ND_INITIALIZER: return sizeof(Node);
+    default:
+      return (char *)&layout.variable - (char *)&layout +
+             sizeof(layout.variable);
+  }
+}
+
+// Allocate a zero-cleared node of the kind from the arena
+Node *node_alloc(NodeKind kind)
+{
+  Node *node = ast_alloc(node_size(kind));
+  node->kind = kind;
+  return node;
+}
+
 Node *new_node(NodeKind kind, Node *lhs, Node *rhs, Token *token)
 {
-  Node *node = calloc(1, sizeof(Node));
+  Node *node = node_alloc(kind);
   node->kind = kind;
   node->lhs = lhs;
   node->rhs = rhs;
@@ -189,15 +270,34 @@ Node *new_node(NodeKind kind, Node *lhs, Node *rhs, Token *token)
 
 Node *new_node_num(long long val)
 {
-  Node *node = calloc(1, sizeof(Node));
-  node->kind = ND_NUM;
+  Node *node = node_alloc(ND_NUM);
   node->num_val = val;
-  Type *t = alloc_type(TYPE_INT);
-  t->is_signed = true;
-  node->type = t;
+  node->type = basic_type(TYPE_INT, true);
   return node;
 }
 
+// The type of an integer constant is the first of int, long and long long
+// allowed by its suffix that can represent its value (C11 6.4.4.1). The
+// unsigned types are taken with a u suffix, and also after the signed type of
+// the same rank for octal and hexadecimal constants.
+static Type *integer_constant_type(unsigned long long value, uint8_t suffix,
+                                   bool is_decimal)
+{
+  TypeKind kinds[] = {TYPE_INT, TYPE_LONG, TYPE_LONGLONG};
+  bool is_unsigned = suffix & NUMBER_UNSIGNED;
+  size_t i = suffix & NUMBER_LONGLONG ? 2 : suffix & NUMBER_LONG ? 1 : 0;
+  for (; i < 3; i++)
+  {
+    unsigned long long max = 1ULL << (size_of_real(kinds[i]) * 8 - 1);
+    if (!is_unsigned && value < max)
+      return basic_type(kinds[i], true);
+    if ((is_unsigned || !is_decimal) && value <= max * 2 - 1)
+      return basic_type(kinds[i], false);
+  }
+  // Too large for long long, which gcc takes as unsigned
+  return basic_type(TYPE_LONGLONG, false);
+}
+
 void new_nest()
 {
   new_nest_type();
@@ -219,10 +319,10 @@ Vector *parameter_type_list(Vector **type_list, Type *type,
   if (type_list)
     vector_push(*type_list, type);
   Vector *list = vector_new();
-  Token *old = get_token();
-  if (consume("void", TK_IDENT) && consume(")", TK_RESERVED))
+  size_t old = get_token_position();
+  if (consume_keyword(KW_VOID) && consume(")", TK_RESERVED))
     return list;
-  set_token(old);
+  set_token_position(old);
   while (!consume(")", TK_RESERVED))
   {
     if (consume("...", TK_RESERVED))
@@ -230,7 +330,7 @@ Vector *parameter_type_list(Vector **type_list, Type *type,
       vector_push(list,
                   new_node(ND_VARIABLE_ARGS, NULL, NULL, get_old_token()));
       if (type_list)
-        vector_push(*type_list, alloc_type(TYPE_VARIABLES));
+        vector_push(*type_list, basic_type(TYPE_VARIABLES, false));
       expect(")", TK_RESERVED);
       break;
     }
@@ -264,10 +364,9 @@ FuncBlock *parser()
   pr_debug("Starting parser...");
   head.next = NULL;
   FuncBlock *pointer = &head;
-  init_types();
   while (!at_eof())
   {
-    FuncBlock *new = calloc(1, sizeof(FuncBlock));
+    FuncBlock *new = ast_alloc(sizeof(FuncBlock));
     pointer->next = new;
     new->node = external_declaration();
     pointer = new;
@@ -330,7 +429,7 @@ Node *declaration(Type *type, bool is_external_declaration,
 
     while (!consume("}", TK_RESERVED))
     {
-      NDBlock *next = calloc(1, sizeof(NDBlock));
+      NDBlock *next = ast_alloc(sizeof(NDBlock));
       pointer->next = next;
       next->node = block_item();
       pointer = next;
@@ -372,15 +471,12 @@ bool consume_array(Type **type)
 {
   if (consume("[", TK_RESERVED))
   {
-    Type *new = alloc_type(TYPE_ARRAY);
-    if (peek("]", TK_RESERVED))
-      new->size = 0;
-    else
-      new->size = eval_constant_expression();
+    size_t size = 0;
+    if (!peek("]", TK_RESERVED))
+      size = eval_constant_expression();
     expect("]", TK_RESERVED);
     consume_array(type);
-    new->ptr_to = *type;
-    *type = new;
+    *type = array_of(*type, size);
     return true;
   }
   return false;
@@ -405,8 +501,7 @@ Node *declarator_internal(Type **type, Token *token,
     if (token && is_builtin_function(&node, token, true))
       return node;
     consume("(", TK_RESERVED);
-    node = calloc(1, sizeof(Node));
-    node->kind = ND_FUNCDEF;
+    node = node_alloc(ND_FUNCDEF);
     node->token = token;
     Type *new = alloc_type(TYPE_FUNC);
     new->param_list = vector_new();
@@ -423,9 +518,8 @@ Node *declarator_internal(Type **type, Token *token,
   else
     consume_array(type);
 
-  Node *node = calloc(1, sizeof(Node));
+  Node *node = node_alloc(ND_VAR);
   node->token = token;
-  node->kind = ND_VAR;
   node->type = *type;
   return node;
 }
@@ -461,11 +555,9 @@ Type *pointer(Type *type)
   if (type)
     while (consume("*", TK_RESERVED))
     {
-      Type *new = alloc_type(TYPE_PTR);
-      new->ptr_to = type;
-      type = new;
-      while (consume("const", TK_IDENT) || consume("volatile", TK_IDENT) ||
-             consume("restrict", TK_IDENT))
+      type = pointer_to(type);
+      while (consume_keyword(KW_CONST) || consume_keyword(KW_VOLATILE) ||
+             consume_keyword(KW_RESTRICT))
         ;
     }
   return type;
@@ -478,8 +570,7 @@ Node *type_name()
   if (!type)
     return NULL;
   type = abstract_declarator(type);
-  Node *node = calloc(1, sizeof(Node));
-  node->kind = ND_TYPE_NAME;
+  Node *node = node_alloc(ND_TYPE_NAME);
   node->type = type;
   return node;
 }
@@ -490,11 +581,22 @@ Type *abstract_declarator(Type *type)
   return direct_abstract_declarator(type);
 }
 
+// Rebuild the pointers and arrays wrapping the innermost type of type around
+// tail instead. They may be interned, so they are not modified in place.
+static Type *replace_tail_type(Type *type, Type *tail)
+{
+  if (type->type == TYPE_PTR)
+    return pointer_to(replace_tail_type(type->ptr_to, tail));
+  if (type->type == TYPE_ARRAY)
+    return array_of(replace_tail_type(type->ptr_to, tail), type->size);
+  return tail;
+}
+
 // Allow even if it does not match direct_abstract_declarator
 Type *direct_abstract_declarator(Type *type)
 {
   bool was_grouped = false;
-  Token *old = get_token();
+  size_t old = get_token_position();
   if (consume("(", TK_RESERVED))
   {
     if (!is_type_specifier(get_token()) && !peek(")", TK_RESERVED))
@@ -504,7 +606,7 @@ Type *direct_abstract_declarator(Type *type)
       was_grouped = true;
     }
     else
-      set_token(old);
+      set_token_position(old);
   }
 
   for (;;)
@@ -517,25 +619,13 @@ Type *direct_abstract_declarator(Type *type)
       if (was_grouped)
       {
         Type *tail = type;
-        Type *parent_of_tail = NULL;
         while (tail->type == TYPE_ARRAY || tail->type == TYPE_PTR)
-        {
-          parent_of_tail = tail;
           tail = tail->ptr_to;
-        }
 
         Type *func_type = alloc_type(TYPE_FUNC);
         func_type->param_list = vector_new();
         parameter_type_list(&func_type->param_list, tail, 0);
-
-        if (parent_of_tail)
-        {
-          parent_of_tail->ptr_to = func_type;
-        }
-        else
-        {
-          type = func_type;
-        }
+        type = replace_tail_type(type, func_type);
       }
       else
       {
@@ -554,8 +644,7 @@ Node *initializer(Node *assigned)
 {
   if (consume("{", TK_RESERVED))
   {
-    Node *node = calloc(1, sizeof(Node));
-    node->kind = ND_INITIALIZER;
+    Node *node = node_alloc(ND_INITIALIZER);
     node->initialize.init_list = vector_new();
     node->initialize.is_top_initializer = true;
     node->initialize.assigned = assigned;
@@ -587,10 +676,10 @@ Node *block_item()
 Node *labeled_statement()
 {
   Node *node = NULL;
-  if (consume("case", TK_IDENT) || consume("default", TK_IDENT))
+  if (consume_keyword(KW_CASE) || consume_keyword(KW_DEFAULT))
   {
     node = new_node(ND_CASE, NULL, NULL, get_old_token());
-    if (get_old_token()->len == 4)  // case
+    if (token_keyword(get_old_token()) == KW_CASE)
     {
       node->jump.is_case = true;
       node->jump.constant_expression = eval_constant_expression();
@@ -622,17 +711,16 @@ Node *statement()
   // Determine if it's a block: compound-statement
   if (consume("{", TK_RESERVED))
   {
-    Node *node = calloc(1, sizeof(Node));
+    Node *node = node_alloc(ND_BLOCK);
     NDBlock head;
     head.next = NULL;
     NDBlock *pointer = &head;
-    node->kind = ND_BLOCK;
     new_nest();
     for (;;)
     {
       if (consume("}", TK_RESERVED))
         break;
-      NDBlock *next = calloc(1, sizeof(NDBlock));
+      NDBlock *next = ast_alloc(sizeof(NDBlock));
       pointer->next = next;
       next->node = block_item();
       pointer = next;
@@ -644,16 +732,16 @@ Node *statement()
 
   // selection-statement
   // Determine if it's an if statement and if it has an else clause
-  if (consume("if", TK_IDENT))
+  if (consume_keyword(KW_IF))
   {
-    Node *node = calloc(1, sizeof(Node));
+    Node *node = node_alloc(ND_IF);
     new_nest();
     node->control.label = generate_label_name(ND_IF);
     expect("(", TK_RESERVED);
     node->control.condition = expression();
     expect(")", TK_RESERVED);
     node->control.true_code = statement();
-    if (consume("else", TK_IDENT))
+    if (consume_keyword(KW_ELSE))
     {
       node->kind = ND_ELIF;
       node->control.false_code = statement();
@@ -665,10 +753,9 @@ Node *statement()
     exit_nest();
     return node;
   }
-  if (consume("switch", TK_IDENT))
+  if (consume_keyword(KW_SWITCH))
   {
-    Node *node = calloc(1, sizeof(Node));
-    node->kind = ND_SWITCH;
+    Node *node = node_alloc(ND_SWITCH);
     new_nest();
     expect("(", TK_RESERVED);
     node->control.label = generate_label_name(ND_SWITCH);
@@ -681,10 +768,9 @@ Node *statement()
 
   // iteration-statement
   // Determine if it's a while loop
-  if (consume("while", TK_IDENT))
+  if (consume_keyword(KW_WHILE))
   {
-    Node *node = calloc(1, sizeof(Node));
-    node->kind = ND_WHILE;
+    Node *node = node_alloc(ND_WHILE);
     new_nest();
     node->control.label = generate_label_name(ND_WHILE);
     expect("(", TK_RESERVED);
@@ -695,14 +781,13 @@ Node *statement()
     return node;
   }
   // Determine if it's a do-while loop
-  if (consume("do", TK_IDENT))
+  if (consume_keyword(KW_DO))
   {
     new_nest();
-    Node *node = calloc(1, sizeof(Node));
+    Node *node = node_alloc(ND_DO);
     node->control.label = generate_label_name(ND_DO);
     node->control.true_code = statement();
-    node->kind = ND_DO;
-    expect("while", TK_IDENT);
+    expect_keyword(KW_WHILE);
     expect("(", TK_RESERVED);
     node->control.condition = expression();
     expect(")", TK_RESERVED);
@@ -711,10 +796,9 @@ Node *statement()
     return node;
   }
   // Determine if it's a for loop
-  if (consume("for", TK_IDENT))
+  if (consume_keyword(KW_FOR))
   {
-    Node *node = calloc(1, sizeof(Node));
-    node->kind = ND_FOR;
+    Node *node = node_alloc(ND_FOR);
     new_nest();
     node->control.label = generate_label_name(ND_FOR);
     expect("(", TK_RESERVED);
@@ -725,9 +809,8 @@ Node *statement()
       node->control.init = declaration(type, false, storage_class_specifier);
     else if (!consume(";", TK_RESERVED))
     {
-      Node *new = calloc(1, sizeof(Node));
+      Node *new = node_alloc(ND_DISCARD_EXPR);
       node->control.init = new;
-      new->kind = ND_DISCARD_EXPR;
       new->lhs = expression();
       expect(";", TK_RESERVED);
     }
@@ -738,9 +821,8 @@ Node *statement()
     }
     if (!consume(")", TK_RESERVED))
     {
-      Node *new = calloc(1, sizeof(Node));
+      Node *new = node_alloc(ND_DISCARD_EXPR);
       node->control.update = new;
-      new->kind = ND_DISCARD_EXPR;
       new->lhs = expression();
       expect(")", TK_RESERVED);
     }
@@ -752,19 +834,19 @@ Node *statement()
   Node *node = labeled_statement();
   if (node)
     return node;
-  if (consume("return", TK_IDENT))
+  if (consume_keyword(KW_RETURN))
     node = new_node(ND_RETURN, expression(), NULL, get_old_token());
-  else if (consume("continue", TK_IDENT))
+  else if (consume_keyword(KW_CONTINUE))
   {
     node = new_node(ND_GOTO, NULL, NULL, get_old_token());
     node->jump.label_name = find_jmp_target(1);
   }
-  else if (consume("break", TK_IDENT))
+  else if (consume_keyword(KW_BREAK))
   {
     node = new_node(ND_GOTO, NULL, NULL, get_old_token());
     node->jump.label_name = find_jmp_target(2);
   }
-  else if (consume("goto", TK_IDENT))
+  else if (consume_keyword(KW_GOTO))
   {
     node = new_node(ND_GOTO, NULL, NULL, get_old_token());
     node->jump.label_name = mangle_goto_label(expect_ident());
@@ -1020,6 +1102,7 @@ Node *multiplicative_expression()
 Node *cast_expression()
 {
   Token *tok = get_token();
+  size_t old = get_token_position();
   if (consume("(", TK_RESERVED) && is_type_specifier(get_token()))
   {
     Node *node = type_name();
@@ -1027,7 +1110,7 @@ Node *cast_expression()
     node = new_node(ND_CAST, cast_expression(), node, tok);
     return node;
   }
-  set_token(tok);
+  set_token_position(old);
   return unary_expression();
 }
 
@@ -1041,17 +1124,17 @@ Node *unary_expression()
     return new_node(ND_PREINCREMENT, unary_expression(), NULL, get_old_token());
   if (consume("--", TK_RESERVED))
     return new_node(ND_PREDECREMENT, unary_expression(), NULL, get_old_token());
-  if (consume("sizeof", TK_IDENT))
+  if (consume_keyword(KW_SIZEOF))
   {
     Token *old = get_old_token();
-    Token *token = get_token();
+    size_t position = get_token_position();
     if (consume("(", TK_RESERVED) && is_type_specifier(get_token()))
     {
       Node *node = type_name();
       expect(")", TK_RESERVED);
       return new_node(ND_SIZEOF, node, NULL, old);
     }
-    set_token(token);
+    set_token_position(position);
     return new_node(ND_SIZEOF, unary_expression(), NULL, old);
   }
   if (consume("+", TK_RESERVED))
@@ -1139,12 +1222,11 @@ Node *primary_expression()
     {
       if (type && !type->param_list)
         error_at(token->str, token->len, "invalid function call");
-      Node *node = calloc(1, sizeof(Node));
+      Node *node = node_alloc(ND_FUNCCALL);
       node->type = type;
       // Function call
       expect("(", TK_RESERVED);
       node->token = token;
-      node->kind = ND_FUNCCALL;
       node->func.expr = vector_new();
       while (!consume(")", TK_RESERVED))
       {
@@ -1175,9 +1257,8 @@ Node *primary_expression()
       case function_name: unreachable(); break;
       case variables_name:
       {  // It is known to be a variable
-        Node *node = calloc(1, sizeof(Node));
+        Node *node = node_alloc(ND_VAR);
         node->token = token;
-        node->kind = ND_VAR;
         node->variable.is_new_var = false;
         node->variable.var = var;
         return node;
@@ -1186,12 +1267,11 @@ Node *primary_expression()
       {
         if (token->len == 8 && !strncmp(token->str, "__func__", 8))
         {  // Support for __func__
-          Node *node = calloc(1, sizeof(Node));
-          node->token = calloc(1, sizeof(Token));
+          Node *node = node_alloc(ND_STRING);
+          node->token = token_alloc();
           node->token->kind = TK_STRING;
           node->token->str = program_name;
           node->token->len = program_name_len;
-          node->kind = ND_STRING;
           return node;
         }
         error_at(token->str, token->len, "variables %.*s is not defined",
@@ -1203,8 +1283,7 @@ Node *primary_expression()
   Token *string = consume_string();
   if (string)
   {
-    Node *node = calloc(1, sizeof(Node));
-    node->kind = ND_STRING;
+    Node *node = node_alloc(ND_STRING);
     node->token = string;
     return node;
   }
@@ -1235,8 +1314,14 @@ Node *primary_expression()
       num_val = char_token->str[0];
     return new_node_num(num_val);
   }
-  long long num;
-  if (consume_number(&num))
-    return new_node_num(num);
+  unsigned long long num;
+  uint8_t suffix;
+  if (consume_number(&num, &suffix))
+  {
+    Node *node = new_node_num(num);
+    node->type = integer_constant_type(
+        num, suffix, get_old_token()->atom->number_base == 10);
+    return node;
+  }
   return NULL;
 }
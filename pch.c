@@ -0,0 +1,325 @@
+// ------------------------------------------------------------------------------------
+// precompiled header
+// ------------------------------------------------------------------------------------
+
+#include "include/pch.h"
+
+#ifdef SELF_HOST
+#include "test/compiler_header.h"
+#else
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#endif
+
+#include "include/define.h"
+#include "include/error.h"
+#include "include/file.h"
+#include "include/header.h"
+#include "include/output.h"
+#include "include/parser.h"
+#include "include/type.h"
+#include "include/vector.h"
+
+// A precompiled header holds the state left by preprocessing and parsing a
+// header prefix: the preprocessed tokens, the macros, the include guards and
+// the declared names and types.
+// Every value is a uint32_t and the strings are offsets into the string pool,
+// so the file can be used wherever it is mapped.
+//
+//   magic        "MYCCPCH2"
+//   string pool  size, bytes
+//   headers      count, (path, guard, is_once) ...
+//   tokens       count, token ...
+//   macros       count, (kind, name, parameters, replacement list) ...
+//   has_types    1 if the type namespaces follow (see type.c), else 0
+//
+// A string is (offset, length), a token is (kind, string) and a token list
+// is (count, token ...). The parameters are only present for function-like
+// macros.
+// The type namespaces are only written when the prefix declares nothing that
+// needs code, so that the compiler can take them instead of parsing the
+// tokens again.
+#define PCH_MAGIC "MYCCPCH2"
+#define PCH_MAGIC_LEN 8
+
+// Growable byte buffer
+typedef struct
+{
+  char *data;
+  size_t len;
+  size_t capacity;
+} pch_buffer;
+
+static pch_buffer pch_pool;     // String pool
+static pch_buffer pch_records;  // Everything following the string pool
+
+static void buffer_append(pch_buffer *buffer, void *data, size_t len)
+{
+  if (buffer->len + len > buffer->capacity)
+  {
+    buffer->capacity = buffer->capacity ? buffer->capacity * 2 : 4096;
+    while (buffer->len + len > buffer->capacity)
+      buffer->capacity *= 2;
+    buffer->data = realloc(buffer->data, buffer->capacity);
+  }
+  memcpy(buffer->data + buffer->len, data, len);
+  buffer->len += len;
+}
+
+void pch_write_u32(size_t value)
+{
+  uint32_t u32 = value;
+  buffer_append(&pch_records, &u32, sizeof(u32));
+}
+
+void pch_write_string(char *str, size_t len)
+{
+  pch_write_u32(pch_pool.len);
+  pch_write_u32(len);
+  if (len)
+    buffer_append(&pch_pool, str, len);
+}
+
+static void write_token(Token *token)
+{
+  pch_write_u32(token->kind);
+  pch_write_string(token->str, token->str ? token->len : 0);
+}
+
+static void write_token_list(Vector *tokens)
+{
+  pch_write_u32(vector_size(tokens));
+  for (size_t i = 1; i <= vector_size(tokens); i++)
+    write_token(vector_peek_at(tokens, i));
+}
+
+// Whether node, a file scope declaration, only declares names
+static bool is_declaration_only(Node *node)
+{
+  if (!node || node->kind == ND_NOP)
+    return true;
+  return node->kind == ND_DECLARATOR_LIST && is_declaration_only(node->lhs) &&
+         is_declaration_only(node->rhs);
+}
+
+// Writes the precompiled header of the preprocessed tokens from token.
+// The tokens from declarations, which are not parsed yet, are parsed for the
+// type namespaces.
+void pch_write(Token *token, Token *declarations, char *filename)
+{
+  size_t count = 0;
+  for (size_t i = 0; i < HEADER_TABLE_SIZE; i++)
+    for (Header *header = header_table[i]; header; header = header->next)
+      if (header->guard || header->is_once)
+        count++;
+  pch_write_u32(count);
+  for (size_t i = 0; i < HEADER_TABLE_SIZE; i++)
+    for (Header *header = header_table[i]; header; header = header->next)
+      if (header->guard || header->is_once)
+      {
+        pch_write_string(header->path->str, header->path->len);
+        if (header->guard)
+          pch_write_string(header->guard->str, header->guard->len);
+        else
+          pch_write_string(NULL, 0);
+        pch_write_u32(header->is_once);
+      }
+
+  // Voided tokens and the TK_EOF are left out. An empty string literal also
+  // has no length, so the voided tokens are told by their missing string.
+  count = 0;
+  for (Token *ptr = token; ptr; ptr = ptr->next)
+    if (ptr->str && ptr->kind != TK_EOF)
+      count++;
+  pch_write_u32(count);
+  for (Token *ptr = token; ptr; ptr = ptr->next)
+    if (ptr->str && ptr->kind != TK_EOF)
+      write_token(ptr);
+
+  count = 0;
+  for (size_t i = 0; i < macro_table_size; i++)
+    if (macro_table[i].macro)
+      count++;
+  pch_write_u32(count);
+  for (size_t i = 0; i < macro_table_size; i++)
+  {
+    macro_slot *slot = &macro_table[i];
+    if (!slot->macro)
+      continue;
+    pch_write_u32(slot->kind);
+    pch_write_string(slot->name->str, slot->name->len);
+    if (slot->kind == 1)
+      write_token_list(
+          ((object_like_macro_storage *)slot->macro)->token_string);
+    else
+    {
+      function_like_macro_storage *macro = slot->macro;
+      write_token_list(macro->arguments);
+      write_token_list(macro->token_string);
+    }
+  }
+
+  fix_token_head(declarations);
+  index_tokens();
+  bool has_types = true;
+  for (FuncBlock *block = parser(); block && has_types; block = block->next)
+    has_types = is_declaration_only(block->node);
+  has_types = has_types && !vector_size(get_string_list());
+  pch_write_u32(has_types);
+  if (has_types)
+    write_type_namespaces();
+
+  output_open(filename);
+  output_write(PCH_MAGIC, PCH_MAGIC_LEN);
+  uint32_t pool_size = pch_pool.len;
+  output_write((char *)&pool_size, sizeof(pool_size));
+  output_write(pch_pool.data, pch_pool.len);
+  output_write(pch_records.data, pch_records.len);
+  output_close();
+}
+
+// Reading position in the mapped file
+static char *pch_pointer;
+static char *pch_end;
+static char *pch_pool_start;
+static uint32_t pch_pool_size;
+
+uint32_t pch_read_u32()
+{
+  if (pch_end - pch_pointer < (long)sizeof(uint32_t))
+    error_exit("precompiled header is truncated");
+  uint32_t value;
+  memcpy(&value, pch_pointer, sizeof(value));
+  pch_pointer += sizeof(value);
+  return value;
+}
+
+// Returns the string in the pool, which is not null-terminated
+char *pch_read_string(uint32_t *len)
+{
+  uint32_t offset = pch_read_u32();
+  *len = pch_read_u32();
+  if (offset > pch_pool_size || *len > pch_pool_size - offset)
+    error_exit("precompiled header is broken");
+  return pch_pool_start + offset;
+}
+
+static Atom *read_atom()
+{
+  uint32_t len;
+  char *str = pch_read_string(&len);
+  return len ? atom_intern(str, len) : NULL;
+}
+
+// Returns a new identifier token of the string in the pool, or NULL for an
+// empty string
+Token *pch_read_identifier()
+{
+  Atom *atom = read_atom();
+  if (!atom)
+    return NULL;
+  Token *identifier = token_alloc();
+  identifier->kind = TK_IDENT;
+  identifier->atom = atom;
+  identifier->str = identifier->atom->str;
+  identifier->len = identifier->atom->len;
+  return identifier;
+}
+
+static Token *read_token()
+{
+  Token *token = token_alloc();
+  token->kind = pch_read_u32();
+  if (token->kind >= TK_END)
+    error_exit("precompiled header is broken");
+  token->str = pch_read_string(&token->len);
+  if (token->kind == TK_IDENT)
+  {
+    token->atom = atom_intern(token->str, token->len);
+    if ('0' <= *token->str && *token->str <= '9')
+      token_number(token, NULL, NULL);  // as the tokenizer does
+  }
+  return token;
+}
+
+static void read_token_list(Vector *tokens)
+{
+  for (uint32_t count = pch_read_u32(); count; count--)
+    vector_push(tokens, read_token());
+}
+
+// Loads the precompiled header: the macros and the include guards are
+// registered, and the preprocessed tokens are returned. The token strings
+// point into the mapped file.
+// If the header has the type namespaces they are restored, and has_types is
+// set as the parser must not see the returned tokens again.
+Token *pch_read(char *filename, bool *has_types)
+{
+  FILE *fin = fopen(filename, "r");
+  struct stat file_stat;
+  if (!fin || fstat(fileno(fin), &file_stat) == -1)
+    error_exit("cannot read %s: %s", filename, strerror(errno));
+  pch_pointer = file_read(fin);
+  pch_end = pch_pointer + file_stat.st_size;
+  if (file_stat.st_size < PCH_MAGIC_LEN ||
+      strncmp(pch_pointer, PCH_MAGIC, PCH_MAGIC_LEN))
+    error_exit("%s is not a precompiled header", filename);
+  pch_pointer += PCH_MAGIC_LEN;
+  pch_pool_size = pch_read_u32();
+  if (pch_pool_size > (size_t)(pch_end - pch_pointer))
+    error_exit("precompiled header is truncated");
+  pch_pool_start = pch_pointer;
+  pch_pointer += pch_pool_size;
+
+  for (uint32_t count = pch_read_u32(); count; count--)
+  {
+    uint32_t len;
+    char *path_str = pch_read_string(&len);
+    char *path = malloc(len + 1);
+    memcpy(path, path_str, len);
+    path[len] = '\0';
+    Header *header = header_find(path);
+    header->guard = read_atom();
+    header->is_once = pch_read_u32();
+  }
+
+  Token head;
+  head.next = NULL;
+  Token *cur = &head;
+  for (uint32_t count = pch_read_u32(); count; count--)
+  {
+    cur->next = read_token();
+    cur = cur->next;
+  }
+
+  for (uint32_t count = pch_read_u32(); count; count--)
+  {
+    uint32_t kind = pch_read_u32();
+    Vector *token_list = vector_new();
+    Token *identifier = pch_read_identifier();
+    if (!identifier)
+      error_exit("precompiled header is broken");
+    vector_push(token_list, identifier);
+    if (kind == 1)
+    {
+      read_token_list(token_list);
+      add_object_like_macro(token_list);
+    }
+    else
+    {
+      Vector *arguments = vector_new();
+      read_token_list(arguments);
+      vector_push(token_list, arguments);
+      read_token_list(token_list);
+      add_function_like_macro(token_list);
+    }
+  }
+  *has_types = pch_read_u32();
+  if (*has_types)
+    read_type_namespaces();
+  return head.next;
+}
@@ -7,6 +7,7 @@
 #ifdef SELF_HOST
 #include "test/compiler_header.h"
 #else
+#include <errno.h>
 #include <stdio.h>
 #include <string.h>
 #endif
@@ -14,9 +15,10 @@
 #include "include/conditional_inclusion.h"
 #include "include/debug.h"
 #include "include/define.h"
+#include "include/dependency.h"
 #include "include/error.h"
 #include "include/file.h"
-#include "include/include_paths.h"
+#include "include/output.h"
 #include "include/tokenizer.h"
 
 Vector *Conditional_Inclusion_List;
@@ -24,6 +26,12 @@ Vector *Conditional_Inclusion_List;
 char *File_Name;
 size_t File_Line = 1;
 char *File_Start;
+char *File_End;     // End of the file (NULL: '\0' terminated)
+Header *File_Header;  // NULL if the file is not read by #include
+guard_state File_Guard_State;
+Atom *File_Guard;  // Include guard candidate
+char *File_Rest;    // Part of the file not tokenized yet (see tokenizer())
+Token *File_Next;   // Token following the file
 long long include_level = -1;
 
 #if defined(__GNUC__) || defined(__MYCC__)
@@ -47,6 +55,30 @@ void token_void(Token *token)
   token->kind = TK_IGNORABLE;
   token->str = NULL;
   token->len = 0;
+  token->atom = NULL;
+}
+
+// Returns the next token. If the tokenizer has stopped after token, the rest
+// of the file is tokenized first.
+Token *token_next_lazy(Token *token)
+{
+  if (!token->next && File_Rest)
+    token->next =
+        File_Header
+            ? header_tokenize(File_Header, File_Rest, File_Next, &File_Rest)
+            : tokenize_rest(&File_Rest, File_End, File_Next);
+  return token->next;
+}
+
+// Skips the group following the directive line ending with linebreak.
+// The tokenizer always stops after such a line, so the group has not been
+// tokenized yet.
+void skip_group(Token *linebreak)
+{
+  if (linebreak->next || !File_Rest)
+    error_at(linebreak->str, linebreak->len,
+             "Conditional directive is not at the beginning of a line.");
+  linebreak->next = skip_conditional_group(File_Rest, File_End, &File_Rest);
 }
 
 Token *token_next_not_ignorable(Token *token)
@@ -55,20 +87,20 @@ Token *token_next_not_ignorable(Token *token)
   {
     if (token->kind == TK_ILB)
       line_count();
-    token = token->next;
+    token = token_next_lazy(token);
   } while (token->kind == TK_IGNORABLE || token->kind == TK_ILB);
   return token;
 }
 
 Token *token_next_not_ignorable_void(Token *token)
 {
-  token = token->next;
+  token = token_next_lazy(token);
   while (token->kind == TK_IGNORABLE || token->kind == TK_ILB)
   {
     if (token->kind == TK_ILB)
       line_count();
     token_void(token);
-    token = token->next;
+    token = token_next_lazy(token);
   }
   return token;
 }
@@ -87,6 +119,8 @@ size_t get_current_directory_path()
 }
 
 Token *preprocess(char *input, char *end, char *file_name, Token *token);
+static Token *preprocess_file(char *input, char *end, char *file_name,
+                              Header *header, Token *token);
 
 // #~ Preprocessor processing
 Token *directive(Token *old)
@@ -97,21 +131,13 @@ Token *directive(Token *old)
   {
     case 2:
       if (!strncmp(token->str, "if", 2))
-      {
-        Vector *conditional_list;
-        for (;;)
-        {
-          if (!vector_has_data(Conditional_Inclusion_List))
-            unreachable();
-          conditional_list = vector_shift(Conditional_Inclusion_List);
-          if (old == vector_peek_at(conditional_list, 1))
-            break;
-        }
-        conditional_inclusion(token_if, conditional_list);
-        return token->next;
-      }
+        return conditional_inclusion(token_if, token);
       break;
     case 4:
+      if (!strncmp(token->str, "elif", 4))
+        return conditional_inclusion(token_elif, token);
+      if (!strncmp(token->str, "else", 4))
+        return conditional_inclusion(token_else, token);
       if (!strncmp(token->str, "line", 4))
       {
         unimplemented();
@@ -120,19 +146,9 @@ Token *directive(Token *old)
       break;
     case 5:
       if (!strncmp(token->str, "ifdef", 5))
-      {
-        Vector *conditional_list;
-        for (;;)
-        {
-          if (!vector_has_data(Conditional_Inclusion_List))
-            unreachable();
-          conditional_list = vector_shift(Conditional_Inclusion_List);
-          if (old == vector_peek_at(conditional_list, 1))
-            break;
-        }
-        conditional_inclusion(token_ifdef, conditional_list);
-        return token->next;
-      }
+        return conditional_inclusion(token_ifdef, token);
+      if (!strncmp(token->str, "endif", 5))
+        return conditional_inclusion(token_endif, token);
       if (!strncmp(token->str, "error", 5))
         error_at(token->str, token->len, "#error directive found");
       if (!strncmp(token->str, "undef", 5))
@@ -151,9 +167,7 @@ Token *directive(Token *old)
         Token *ptr = token_next_not_ignorable_void(token);
 
         Vector *token_list = vector_new();
-        Token *new = malloc(sizeof(Token));
-        memcpy(new, ptr, sizeof(Token));
-        vector_push(token_list, new);
+        vector_push(token_list, token_copy(ptr));
         token_void(ptr);
         ptr = ptr->next;
         bool is_function_like = false;
@@ -170,14 +184,12 @@ Token *directive(Token *old)
             ptr = token_next_not_ignorable_void(ptr);
             if (ptr->kind == TK_IDENT)
             {
-              Token *new = malloc(sizeof(Token));
-              memcpy(new, ptr, sizeof(Token));
+              Token *new = token_copy(ptr);
               token_void(ptr);
               for (size_t i = 1; i <= vector_size(formal_parameter); i++)
               {
                 Token *argument = vector_peek_at(formal_parameter, i);
-                if (argument->len == new->len &&
-                    !strncmp(argument->str, new->str, argument->len))
+                if (argument->atom == new->atom)
                   error_at(new->str, new->len, "Duplicate macro parameter.");
               }
               vector_push(formal_parameter, new);
@@ -193,11 +205,12 @@ Token *directive(Token *old)
                 error_at(ptr->str, 1, "Invalid identifier.");
               token_void(ptr);
               ptr = token_next_not_ignorable_void(ptr);
-              Token *new = calloc(1, sizeof(Token));
+              Token *new = token_alloc();
               new->kind = TK_IDENT;
               new->len = 3;
               new->str = malloc(3 * sizeof(char));
               new->str[0] = new->str[1] = new->str[2] = '.';
+              new->atom = atom_intern(new->str, 3);
               vector_push(formal_parameter, new);
               break;
             }
@@ -230,9 +243,7 @@ Token *directive(Token *old)
           if (ptr->kind == TK_LINEBREAK)
             break;
 
-          Token *new = malloc(sizeof(Token));
-          memcpy(new, ptr, sizeof(Token));
-          vector_push(token_list, new);
+          vector_push(token_list, token_copy(ptr));
           token_void(ptr);
 
           ptr = ptr->next;
@@ -244,19 +255,7 @@ Token *directive(Token *old)
         return token->next;
       }
       if (!strncmp(token->str, "ifndef", 6))
-      {
-        Vector *conditional_list;
-        for (;;)
-        {
-          if (!vector_has_data(Conditional_Inclusion_List))
-            unreachable();
-          conditional_list = vector_shift(Conditional_Inclusion_List);
-          if (old == vector_peek_at(conditional_list, 1))
-            break;
-        }
-        conditional_inclusion(token_ifndef, conditional_list);
-        return token->next;
-      }
+        return conditional_inclusion(token_ifndef, token);
       if (!strncmp(token->str, "pragma", 6))
       {
         token_void(token);
@@ -268,19 +267,21 @@ Token *directive(Token *old)
           token->kind = TK_IDENT;
           token->str = "char";
           token->len = 4;
-          token = token->next = malloc(sizeof(Token));
+          token->atom = atom_intern(token->str, token->len);
+          token = token->next = token_alloc();
           token->kind = TK_RESERVED;
           token->str = "*";
           token->len = 1;
-          token = token->next = malloc(sizeof(Token));
+          token = token->next = token_alloc();
           token->kind = TK_IDENT;
           token->str = "gcc_predef_start";
           token->len = 16;
-          token = token->next = malloc(sizeof(Token));
+          token->atom = atom_intern(token->str, token->len);
+          token = token->next = token_alloc();
           token->kind = TK_RESERVED;
           token->str = "=";
           token->len = 1;
-          token = token->next = malloc(sizeof(Token));
+          token = token->next = token_alloc();
           char *gcc_predef_str = malloc(gcc_predef_start - gcc_predef_end +
                                         3 /* null terminator*/);
           *(gcc_predef_str) = *(gcc_predef_str + (size_t)gcc_predef_start -
@@ -295,11 +296,20 @@ Token *directive(Token *old)
           token->next = next;
           return next;
         }
+        if (token->len == 4 && !strncmp(token->str, "once", 4))
+        {
+          if (File_Header)
+            File_Header->is_once = true;
+          token_void(token);
+          return token;
+        }
         error_at(token->str, token->len, "Unknown pragma directive.");
         return token_next_not_ignorable_void(token);
       }
       break;
     case 7:
+      if (!strncmp(token->str, "elifdef", 7))
+        return conditional_inclusion(token_elifdef, token);
       if (!strncmp(token->str, "include", 7))
       {
         token_void(token);
@@ -310,6 +320,7 @@ Token *directive(Token *old)
           tmp = token_next_not_ignorable(tmp);
         }
         char *file_name = NULL;  // #include "ident"'s ident
+        char *file_name_location = NULL;  // for error messages
         size_t file_len = 0;
         size_t directory_path_size = get_current_directory_path();
         token = token_next_not_ignorable_void(token);
@@ -318,6 +329,7 @@ Token *directive(Token *old)
           token_void(token);
           token = token->next;
           char *include_file_start = token->str;
+          file_name_location = include_file_start;
           Token *include_file_start_token = token;
           while (token->kind != TK_RESERVED || token->str[0] != '>')
           {
@@ -326,7 +338,7 @@ Token *directive(Token *old)
             file_len += token->len;
             token = token->next;
           }
-          file_name = malloc(file_len + 1 /* '\0' */ + MAX_LIB_PATH_SIZE);
+          file_name = malloc(file_len + 1 /* '\0' */);
           memcpy(file_name, include_file_start, file_len);
           while (token != include_file_start_token)
           {
@@ -335,43 +347,20 @@ Token *directive(Token *old)
           }
         }
         else if (token->kind == TK_STRING)
-        {  // #include " ident "
-          file_len = token->len - 2;
-          file_name = malloc(file_len + 1 /* '\0' */ + MAX_LIB_PATH_SIZE);
-          memcpy(file_name, token->str + 1, token->len - 2);
+        {  // #include " ident " (the token excludes the quotes)
+          file_len = token->len;
+          file_name_location = token->str;
+          file_name = malloc(file_len + 1 /* '\0' */);
+          memcpy(file_name, token->str, token->len);
         }
         else
           error_at(token->str, token->len, "Invalid #include directive.");
         file_name[file_len] = '\0';
-        FILE *include_file_ptr = NULL;
-        if (directory_path_size)
-        {
-          char *file_name_with_dir = malloc(file_len + 1 + directory_path_size);
-          memcpy(file_name_with_dir, File_Name, directory_path_size);
-          memcpy(file_name_with_dir + directory_path_size, file_name,
-                 file_len + 1);
-          include_file_ptr = fopen(file_name_with_dir, "r");
-          if (include_file_ptr)
-            file_name = file_name_with_dir;
-        }
-        else
-          include_file_ptr = fopen(file_name, "r");
-        if (!include_file_ptr)
-        {  // Read stdlib
-          for (size_t i = 0; i < sizeof(lib_path) / sizeof(char *); i++)
-          {
-            memmove(file_name + lib_path_size[i] - 1,
-                    file_name + (i ? lib_path_size[i - 1] - 1 : 0),
-                    file_len + 1);
-            memcpy(file_name, lib_path[i], lib_path_size[i] - 1);
-            pr_debug("file path: %s", file_name);
-            include_file_ptr = fopen(file_name, "r");
-            if (include_file_ptr)
-              break;
-          }
-        }
-        if (!include_file_ptr)
-          error_at(token->str - file_len - 2, file_len, "File not found.");
+        bool is_system;
+        char *path = header_resolve(file_name, token->kind == TK_STRING,
+                                    File_Name, directory_path_size, &is_system);
+        if (!path)
+          error_at(file_name_location, file_len, "File not found.");
         Token *old = token;
         token_void(old);
         token = token_next_not_ignorable_void(token);
@@ -379,7 +368,16 @@ Token *directive(Token *old)
           error_at(token->str, token->len, "Invalid #include directive.");
         File_Line++;
         token_void(token);
-        preprocess(file_read(include_file_ptr), NULL, file_name, old);
+        Header *header = header_find(path);
+        dependency_add(header, path, is_system);
+        if (header_is_skippable(header))
+          return token;  // guarded by #pragma once or a defined include guard
+        FILE *include_file_ptr = fopen(path, "r");
+        if (!include_file_ptr)
+          error_at(file_name_location, file_len, "Cannot open file: %s",
+                   strerror(errno));
+        preprocess_file(header_read(header, include_file_ptr), NULL, path,
+                        header, old);
         return token;
       }
       if (!strncmp(token->str, "#warning", 8))
@@ -388,60 +386,122 @@ Token *directive(Token *old)
         return token_next_not_ignorable_void(token);
       }
       break;
+    case 8:
+      if (!strncmp(token->str, "elifndef", 8))
+        return conditional_inclusion(token_elifndef, token);
+      break;
     default: break;
   }
   error_at(token->str, token->len, "Unknown directive.");
   return NULL;  // unreachable
 }
 
-void preprocessor()
+// Preprocesses the tokens from token to TK_EOF of the file and returns the
+// TK_EOF token
+Token *preprocessor(Token *token)
 {
   pr_debug2("start preprocessor");
-  Token *token = get_token();
   while (token->kind != TK_EOF)
   {
+    // Anything outside of the include guard group means the file is not
+    // guarded (the directives are checked below)
+    if ((File_Guard_State == GUARD_START ||
+         File_Guard_State == GUARD_AFTER_GROUP) &&
+        token->kind != TK_DIRECTIVE && token->kind != TK_IGNORABLE &&
+        token->kind != TK_ILB && token->kind != TK_LINEBREAK)
+      File_Guard_State = GUARD_NONE;
     switch (token->kind)
     {
       case TK_DIRECTIVE:  // If '#' exists at the beginning of the token
+      {
+        guard_state state = File_Guard_State;
         token = directive(token);
+        if ((state == GUARD_START && File_Guard_State == GUARD_START) ||
+            state == GUARD_AFTER_GROUP)
+          File_Guard_State = GUARD_NONE;
+      }
+      break;
+      case TK_LINEBREAK:
+        File_Line++;
+        token_hide_sets_clear();
         break;
-      case TK_LINEBREAK: File_Line++; break;
       case TK_IDENT:
       case TK_RESERVED:
-      case TK_STRING: ident_replacement(token); break;
+      case TK_STRING:
+      {
+        Token *last = ident_replacement(token);
+        if (last)  // the expansion follows last and is rescanned from there
+          token = last;
+      }
+      break;
       default: break;
     }
     // Send to next token
-    token = token->next;
+    token = token_next_lazy(token);
   }
+  return token;
 }
 
 Token *preprocess(char *input, char *end, char *file_name, Token *token)
+{
+  return preprocess_file(input, end, file_name, NULL, token);
+}
+
+// Preprocesses a file. header is the header of a file read by #include, in
+// which the include guard and #pragma once are recorded.
+static Token *preprocess_file(char *input, char *end, char *file_name,
+                              Header *header, Token *token)
 {
   pr_debug("start preprocessing %s", file_name);
   char *old_file_name = File_Name;
   size_t old_file_line = File_Line;
   char *old_file_start = File_Start;
+  char *old_file_end = File_End;
+  char *old_file_rest = File_Rest;
+  Token *old_file_next = File_Next;
+  Header *old_file_header = File_Header;
+  guard_state old_file_guard_state = File_Guard_State;
+  Atom *old_file_guard = File_Guard;
   Vector *old_conditional_inclusion_list = Conditional_Inclusion_List;
   Conditional_Inclusion_List = vector_new();
   Token *next_token = token ? token->next : NULL;
   File_Name = file_name;
   File_Line = 1;
   File_Start = input;
+  File_End = end;
+  File_Next = next_token;
+  File_Header = header;
+  File_Guard_State = GUARD_START;
+  File_Guard = NULL;
   error_init(File_Name, input);
-  Token *token_first = tokenizer(input, end, next_token);
+  // Included files are tokenized through the header cache
+  Token *token_first =
+      header ? header_tokenize(header, input, next_token, &File_Rest)
+             : tokenizer(input, end, next_token, &File_Rest);
   if (token)
     token->next = token_first;
   else
     token = token_first;
   include_level++;
-  preprocessor();
+  Token *eof = preprocessor(token_first);
+  if (header)  // the tokens of the including file follow
+    token_void(eof);
 #ifdef DEBUG
   print_definition();
 #endif
   include_level--;
+  if (vector_has_data(Conditional_Inclusion_List))
+    error_exit("#if directive is not closed.");
+  if (File_Header && File_Guard_State == GUARD_AFTER_GROUP)
+    File_Header->guard = File_Guard;
   vector_free(Conditional_Inclusion_List);
   Conditional_Inclusion_List = old_conditional_inclusion_list;
+  File_End = old_file_end;
+  File_Rest = old_file_rest;
+  File_Next = old_file_next;
+  File_Header = old_file_header;
+  File_Guard_State = old_file_guard_state;
+  File_Guard = old_file_guard;
   File_Name = old_file_name;
   File_Line = old_file_line;
   File_Start = old_file_start;
@@ -453,38 +513,45 @@ Token *preprocess(char *input, char *end, char *file_name, Token *token)
 
 void set_default_definition()
 {
-  char *predef_start =
-      "#define __FILE__ \n#define __LINE__ \n#define __DATE__ \n#define "
-      "__TIME__ \n #define __INCLUDE_LEVEL__\n#define __MYCC__\n#define "
-      "SELF_HOST\n";
-  char *predef_end = predef_start + strlen(predef_start);
-
-  preprocess(predef_start, predef_end, NULL, NULL);
-  if (gcc_compatible)
-    preprocess(gcc_predef_start, gcc_predef_end, NULL, NULL);
+  define_predefined_macros(gcc_compatible);
 }
 
 [[noreturn]]
 void preprocessed_file_writer(Token *token, char *output_filename)
 {
-  FILE *fout = fopen(output_filename, "w");
-  if (fout == NULL)
-  {
-    error_exit("Could not write to file");
-  }
-  for (;;)
+  output_open(output_filename);
+  Token *last = NULL;  // the last token written, NULL after whitespace
+  for (; token; token = token->next)
   {
-    if (!token)
-      break;
-    fprintf(fout, "%.*s", (int)token->len, token->str);
-    token = token->next;
+    if (!token->str)  // voided
+      continue;
+    if (token->kind == TK_IGNORABLE || token->kind == TK_ILB ||
+        token->kind == TK_LINEBREAK)
+      last = NULL;
+    else
+    {
+      // Tokens put next to each other by a macro expansion are separated if
+      // they would be read as others
+      if (last && tokens_would_paste(last, token))
+        output_char(' ');
+      last = token;
+    }
+    // String and character literals are stored without the quotes
+    char quote = token->kind == TK_STRING ? '"'
+                 : token->kind == TK_CHAR ? '\''
+                                          : 0;
+    if (quote)
+      output_char(quote);
+    output_write(token->str, strnlen(token->str, token->len));
+    if (quote)
+      output_char(quote);
   }
+  output_close();
   exit(0);
 }
 
 void init_preprocessor()
 {
   Conditional_Inclusion_List = vector_new();
-  object_like_macro_list = vector_new();
   set_default_definition();
 }
\ No newline at end of file
@@ -82,6 +82,204 @@ assert() {
   fi
 }
 
+assert_preprocess() {
+  input="$1"
+  expected="$2"
+  local compiler_stdout="out/compiler.stdout"
+
+  echo "$input" > out/tmp.c
+
+  if ! "$COMPILER" -E -i out/tmp.c -o out/tmp.i > "$compiler_stdout"; then
+    show_compiler_output_and_exit "PREPROCESSING FAILED" "$compiler_stdout" "$input"
+  fi
+
+  actual=$(grep -v '^[[:space:]]*$' out/tmp.i)
+  if [ "$actual" = "$expected" ]; then
+    echo "$input => $actual"
+  else
+    show_compiler_output_and_exit "'$expected' expected, but got '$actual'" "$compiler_stdout" "$input"
+  fi
+}
+
+# Preprocess $1 and compare the tokens with the output of gcc -E
+assert_preprocess_gcc() {
+  input="$1"
+
+  echo "$input" > out/tmp.c
+  if ! gcc -E -P -o out/gcc.i out/tmp.c; then
+    echo "ERROR: Reference preprocessing with GCC failed for input: '$input'"
+    exit 1
+  fi
+  assert_preprocess "$input" "$(grep -v '^[[:space:]]*$' out/gcc.i)"
+}
+
+# Check that preprocessing $1 fails
+assert_preprocess_error() {
+  input="$1"
+  local compiler_stdout="out/compiler.stdout"
+
+  echo "$input" > out/tmp.c
+  if "$COMPILER" -E -i out/tmp.c -o out/tmp.i > "$compiler_stdout" 2>&1; then
+    show_compiler_output_and_exit "error expected" "$compiler_stdout" "$input"
+  fi
+  echo "$input => error"
+}
+
+# Preprocess "#if $1" with X defined empty and Y defined to 5
+assert_if() {
+  assert_preprocess "#define X
+#define Y 5
+#if $1
+yes
+#else
+no
+#endif" "$2"
+}
+
+# Check that the constant expression $1 is folded to the value $2
+assert_constant() {
+  input="int main() { return $1; }"
+  expected="$2"
+  local compiler_stdout="out/compiler.stdout"
+
+  echo "$input" > out/tmp.c
+  if ! "$COMPILER" -emit-ir -i out/tmp.c -o out/tmp.ir > "$compiler_stdout"; then
+    show_compiler_output_and_exit "COMPILATION FAILED" "$compiler_stdout" "$input"
+  fi
+
+  actual=$(grep 'MOV r0, ' out/tmp.ir | sed 's/.*MOV r0, //')
+  if [ "$actual" = "$expected" ]; then
+    echo "$1 => $actual"
+  else
+    show_compiler_output_and_exit "'$expected' expected, but got '$actual'" "$compiler_stdout" "$input"
+  fi
+}
+
+assert_pch() {
+  header="$1"
+  input="$2"
+  local compiler_stdout="out/compiler.stdout"
+
+  echo "$header" > out/pch.h
+  printf '#include "pch.h"\n%s\n' "$input" > out/tmp.c
+  echo "$input" > out/tmp_pch.c
+
+  if ! "$COMPILER" -emit-pch -i out/pch.h -o out/pch.pch > "$compiler_stdout"; then
+    show_compiler_output_and_exit "PCH GENERATION FAILED" "$compiler_stdout" "$header"
+  fi
+  if ! "$COMPILER" -emit-ir -i out/tmp.c -o out/tmp.ir > "$compiler_stdout"; then
+    show_compiler_output_and_exit "COMPILATION FAILED" "$compiler_stdout" "$input"
+  fi
+  if ! "$COMPILER" -emit-ir -include-pch out/pch.pch -i out/tmp_pch.c -o out/tmp_pch.ir > "$compiler_stdout"; then
+    show_compiler_output_and_exit "COMPILATION WITH PCH FAILED" "$compiler_stdout" "$input"
+  fi
+  if ! cmp -s out/tmp.ir out/tmp_pch.ir; then
+    show_compiler_output_and_exit "IR MISMATCH WITH PCH" "$compiler_stdout" "$input"
+  fi
+
+  echo "$input => pch ok"
+}
+
+assert_cache() {
+  input="$1"
+  expected="$2"
+  shift 2
+  local compiler_stdout="out/compiler.stdout"
+
+  echo "$input" > out/cache.c
+  rm -f out/cache.s
+  "$COMPILER" -cache-dir out/cache "$@" -i out/cache.c -o out/cache.s > "$compiler_stdout"
+  if [ "$expected" = "error" ]; then
+    if [ -s out/cache.s ]; then
+      show_compiler_output_and_exit "COMPILATION SUCCEEDED" "$compiler_stdout" "$input"
+    fi
+    if ls out/cache | grep -q '\.s\.'; then
+      show_compiler_output_and_exit "TEMPORARY FILE LEFT IN CACHE" "$compiler_stdout" "$input"
+    fi
+  else
+    if ! "$COMPILER" "$@" -i out/cache.c -o out/nocache.s > "$compiler_stdout"; then
+      show_compiler_output_and_exit "COMPILATION FAILED" "$compiler_stdout" "$input"
+    fi
+    if ! cmp -s out/cache.s out/nocache.s; then
+      show_compiler_output_and_exit "OUTPUT MISMATCH WITH CACHE" "$compiler_stdout" "$input"
+    fi
+  fi
+  "$COMPILER" -cache-dir out/cache -cache-stats > "$compiler_stdout" 2> out/cache_stats.txt
+  actual=$(head -n 2 out/cache_stats.txt | tr '\n' ' ')
+  if [ "$actual" != "$expected" ] && [ "$expected" != "error" ]; then
+    show_compiler_output_and_exit "'$expected' expected, but got '$actual'" "$compiler_stdout" "$input"
+  fi
+
+  echo "$input $* => $actual"
+}
+
+# Compare the dependencies written to $1 with the flags after it with those of
+# gcc, ignoring where the lines are broken
+normalize_dependency() {
+  sed -e ':a' -e '/\\$/{N;s/\\\n//;ba' -e '}' "$1" | tr -s ' ' | grep -v '^$'
+}
+
+assert_dependency() {
+  dependency_file="$1"
+  shift
+  local compiler_stdout="out/compiler.stdout"
+  local input='out/dep/m a#in$.c'
+  local output='out/dep/m a#in$.s'
+
+  rm -f out/dep/*.d "$dependency_file"
+  if ! gcc -ffreestanding "$@" -c "$input" -o "$output"; then
+    echo "ERROR: Reference build with GCC failed for flags: '$*'"
+    exit 1
+  fi
+  expected=$(normalize_dependency "$dependency_file")
+  rm -f out/dep/*.d "$dependency_file"
+  if ! "$COMPILER" "$@" -i "$input" -o "$output" > "$compiler_stdout"; then
+    show_compiler_output_and_exit "COMPILATION FAILED" "$compiler_stdout" "$*"
+  fi
+  actual=$(normalize_dependency "$dependency_file")
+  if [ "$actual" != "$expected" ]; then
+    show_compiler_output_and_exit "'$expected' expected, but got '$actual'" "$compiler_stdout" "$*"
+  fi
+
+  echo "$* => $actual" | tr '\n' ' '
+  echo
+}
+
+# Link the data only translation unit $1 with the driver $2 built by gcc and
+# compare what it prints with gcc. $3 is the number of string literals
+# expected to be emitted as offsets into others.
+assert_data_print() {
+  input="$1"
+  driver="$2"
+  shared="$3"
+  local compiler_stdout="out/compiler.stdout"
+
+  echo "$input" > out/tmp.c
+  echo "$driver" > out/driver.c
+  if ! gcc -o out/gcc out/driver.c out/tmp.c; then
+    echo "ERROR: Reference build with GCC failed for input: '$input'"
+    exit 1
+  fi
+  ./out/gcc > out/gcc.txt
+
+  if ! "$COMPILER" -i out/tmp.c -o out/out.s > "$compiler_stdout"; then
+    show_compiler_output_and_exit "COMPILATION FAILED" "$compiler_stdout" "$input"
+  fi
+  if ! gcc -z noexecstack -o out/out out/driver.c out/out.s; then
+    show_compiler_output_and_exit "LINKING FAILED" "$compiler_stdout" "$input"
+  fi
+  ./out/out > out/out.txt
+  if ! cmp -s out/out.txt out/gcc.txt; then
+    show_compiler_output_and_exit "OUTPUT MISMATCH" "$compiler_stdout" "$input"
+  fi
+  actual=$(grep -c '^ *\.set ' out/out.s)
+  if [ "$actual" != "$shared" ]; then
+    show_compiler_output_and_exit "$shared shared literals expected, but got $actual" "$compiler_stdout" "$input"
+  fi
+
+  echo "$input => $(cat out/out.txt)"
+}
+
 assert_with_outer_code() {
   input="$1"
   shift
@@ -118,6 +316,151 @@ mkdir -p out
   cd test
   make
 )
+assert_preprocess '#define Y 5
+#define ID(x) x
+ID(ID(Y))' '5'
+assert_preprocess '#define MAX(a,b) ((a)>(b)?(a):(b))
+MAX(MAX(1,2),3)' '((((1)>(2)?(1):(2)))>(3)?(((1)>(2)?(1):(2))):(3))'
+assert_preprocess '#define Y 5
+#define STR(x) #x
+#define XSTR(x) STR(x)
+STR(Y) XSTR(Y)' '"Y" "5"'
+assert_preprocess '#define Y 5
+#define CAT(x,y) x ## y
+#define XCAT(x,y) CAT(x,y)
+CAT(Y,Y) XCAT(Y,Y)' 'YY 55'
+assert_preprocess_gcc '#define F(a,b) +a##b
+#define G(a,b,c) a##b##c
+F(,+) F(+,) F(,) F(+,+) G(,,x) G(x,,) G(,,)-'
+assert_preprocess_gcc '#define G(a,b) [a,b]
+#define Z() z
+#define O(a) [a]
+#define V(a,...) a(__VA_ARGS__)
+G(1,2) G(,) Z() O() O(x) V(1) V(1,2,3)'
+assert_preprocess_error '#define G(a,b) a+b
+G(1)'
+assert_preprocess_error '#define G(a,b) a+b
+G(1,2,3)'
+assert_preprocess_error '#define Z() z
+Z(1)'
+assert_preprocess_gcc '#if 0
+a \
+b \
+c
+/**/ #endif
+x __LINE__
+#if 0
+/* multi
+line */ #else
+y __LINE__
+#endif
+#if 0
+q /* x
+*/ #endif
+" \
+"
+#endif
+z __LINE__'
+assert_preprocess '#define rec(x) x + 1
+rec(rec(1))' '1 + 1 + 1'
+assert_preprocess '#define a a b
+#define id(x) x
+id(a) id(id)(1)' 'a b id(1)'
+assert_preprocess '#define f(a) a*g
+#define g(a) f(a)
+f(2)(9)' '2*9*g'
+assert_if '1 + 2 * 3 == 7 && 10 - 4 - 3 == 3 && 12 / 2 / 3 == 2' 'yes'
+assert_if '1 << 2 + 1 == 8 && (1 | 2 ^ 3 & 1) == 3' 'yes'
+assert_if '1 < 2 == 1 && 3 > 2 > 1 == 0 && 7 % 3 * 2 == 2' 'yes'
+assert_if '-1 > 0u' 'yes'
+assert_if '-1 > 0' 'no'
+assert_if '0xffffffffffffffff == -1 && (0u - 1) / 2 == 0x7fffffffffffffff' 'yes'
+assert_if '(1 ? -1 : 0u) > 0 && -1 / 2u > 1' 'yes'
+assert_if 'defined X && defined(Y) && !defined Z && !defined(Z)' 'yes'
+assert_if 'defined(UNDEF) || UNDEF == 0 && Y == 5' 'yes'
+assert_if '0 ? 1 : 2 == 2' 'yes'
+assert_if '(1 ? 0 ? 3 : 4 : 5) == 4 && (0 ? 1 : 0 ? 2 : 3) == 3' 'yes'
+assert_if '0 && 1 / 0' 'no'
+assert_if '1 || 1 / 0' 'yes'
+assert_if '~0 == -1 && !0 == 1 && - - 1 == 1 && (2 || 0) == 1' 'yes'
+assert_if "'\0' == 0 && 'A' == 65" 'yes'
+assert_if '0 ? 1 / 0 : 1' 'yes'
+assert_constant '-1 < 0U' '0'
+assert_constant '-1 < 0' '1'
+assert_constant '-1L < 0U' '1'
+assert_constant '-1 < 0UL' '0'
+assert_constant '-1 / 2U > 1' '1'
+assert_constant '0xffffffff > 0' '1'
+assert_constant '1UL << 40 > 0xffffffff' '1'
+assert_constant '0x7fffffffff > 0' '1'
+assert_constant 'sizeof(1L)' '8'
+assert_constant 'sizeof(0x7fffffffff)' '8'
+assert_constant 'sizeof(2147483648)' '8'
+assert_constant 'sizeof(0xffffffff)' '4'
+assert_constant '7 % 3' '1'
+assert_preprocess '#if 2 > 3
+a
+#elif 2 - 3 > 0u
+b
+#else
+c
+#endif' 'b'
+assert_pch 'typedef unsigned long size_t;
+typedef struct node node;
+struct node { node *next; int value; union { char c; long l; }; int arr[3]; };
+enum color { RED, GREEN = 5, BLUE };
+extern int counter;
+int add(int a, int b);
+struct outer { struct inner { int x; } in; int y; };
+struct fwd;' 'int counter;
+struct fwd { int z; };
+int f(node *n, struct fwd *p, struct outer *o)
+{
+  size_t s = sizeof(node) + sizeof(struct outer) + sizeof(struct inner);
+  enum color c = BLUE;
+  return n->value + n->next->l + s + c + GREEN + counter + o->in.x + p->z + n->arr[2];
+}'
+assert_pch 'int one() { return 1; }' 'int two() { return 2; }'
+assert_pch 'static char *empty = "";' 'char *full = "x";'
+rm -rf out/dep
+mkdir -p out/dep
+printf '#define ONE 1\n' > 'out/dep/sp ace#h$.h'
+printf '#include <stddef.h>\n#include "sp ace#h$.h"\nint x = ONE;\n' > 'out/dep/m a#in$.c'
+assert_dependency 'out/dep/m a#in$.d' -MD
+assert_dependency 'out/dep/m a#in$.d' -MMD
+assert_dependency 'out/dep/m a#in$.d' -MD -MP
+assert_dependency 'out/dep/m a#in$.d' -MMD -MP
+assert_dependency 'out/dep/dep.d' -MD -MF 'out/dep/dep.d'
+assert_dependency 'out/dep/dep.d' -MD -MF 'out/dep/dep.d' -MT 'target.o'
+assert_dependency 'out/dep/dep.d' -MD -MF 'out/dep/dep.d' -MT '$(OUT)/t#1.o'
+assert_dependency 'out/dep/m a#in$.d' -MMD -MT 'out/dep/target.o' -MP
+rm -rf out/cache
+assert_cache 'int x = 3; int *p = &x;' 'cache hits: 0 cache misses: 1 ' -O0
+assert_cache 'int x = 3; int *p = &x;' 'cache hits: 1 cache misses: 1 ' -O0
+assert_cache '/* same tokens */ int x = 3;
+int *p = &x;' 'cache hits: 2 cache misses: 1 ' -O0
+assert_cache 'int x = 3; int *p = &x;' 'cache hits: 2 cache misses: 2 ' -O1
+assert_cache 'int x = 4; int *p = &x;' 'cache hits: 2 cache misses: 3 ' -O1
+assert_cache 'char *s = "cache"; long y;' 'cache hits: 2 cache misses: 4 ' -O1
+assert_cache 'int f(int a) { return a * 2; }' 'error' -O1
+assert_data_print 'char *a = "barfoo"; char *b = "foo"; char *c = "oo"; char *d = "\101BC";
+char *e = "\101"; char *f = "01"; char *g = "x\\n"; char *h = "\n"; char *i = "\\n";
+char *j = "n"; char *k = "tail\0"; char *l = "";' '#include <stdio.h>
+extern char *a, *b, *c, *d, *e, *f, *g, *h, *i, *j, *k, *l;
+int main() {
+  char *s[] = {a, b, c, d, e, f, g, h, i, j, k, l};
+  for (int n = 0; n < 12; n++)
+    printf("[%s]", s[n]);
+  return 0;
+}' 5
+assert_data_print 'long a = 0x7fffffffff; unsigned long b = 1099511627776UL;
+long long c = 4294967296; int d = sizeof(1L); int e = sizeof(0x7fffffffff);
+int f = sizeof(1U); int g = sizeof(2147483648);' '#include <stdio.h>
+extern long a; extern unsigned long b; extern long long c; extern int d, e, f, g;
+int main() {
+  printf("%ld %lu %lld %d %d %d %d\n", a, b, c, d, e, f, g);
+  return 0;
+}' 0
 assert 'int main() {return 0;}'
 assert 'int main() {return 42; }'
 assert 'int main ( ) {return 10-1;}'
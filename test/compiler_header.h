@@ -8,7 +8,12 @@
 
 typedef unsigned long size_t;
 typedef unsigned char uint8_t;
+typedef unsigned int uint32_t;
+typedef unsigned long uint64_t;
+typedef unsigned long uintptr_t;
 typedef long time_t;
+#define LLONG_MAX 9223372036854775807LL
+#define LLONG_MIN (-LLONG_MAX - 1LL)
 struct tm
 {
   int tm_sec;
@@ -57,9 +62,11 @@ void *memset(void *destt, int size, size_t n);
 int strcmp(char *s1, char *s2);
 int strncmp(char *s1, char *s2, size_t n);
 size_t strlen(char *s);
+size_t strnlen(char *s, size_t maxlen);
 char *strcpy(char *dst, char *src);
 char *strncpy(char *dst, char *src, size_t dsize);
 char *strchr(char *s, int c);
+char *strrchr(char *s, int c);
 char *strstr(char *haystack, char *needle);
 void *malloc(size_t size);
 void free(void *ptr);
@@ -75,16 +82,98 @@ int sprintf(char *str, char *fmt, ...);
 long strtol(char *nptr, char **endptr, int base);
 long long strtoll(char *nptr, char **endptr, int base);
 void exit(int status);
+int atexit(void *function);  // void (*function)(void)
 FILE *fopen(char *pathname, char *mode);
 int fclose(FILE *stream);
 size_t fread(void *ptr, size_t size, size_t nmemb, FILE *stream);
 int fseek(FILE *stream, long offset, int whence);
 long ftell(FILE *stream);
 char *strerror(int errnum);
+char *realpath(char *path, char *resolved_path);
 int isspace(int c);
 int isdigit(int c);
 time_t time(time_t *timer);
 struct tm *localtime(time_t *timer);
 char *asctime(struct tm *tp);
 
+int fileno(FILE *stream);
+int ferror(FILE *stream);
+int getpagesize();
+
+struct timespec
+{
+  long tv_sec;
+  long tv_nsec;
+};
+struct stat
+{
+  unsigned long st_dev;
+  unsigned long st_ino;
+  unsigned long st_nlink;
+  unsigned int st_mode;
+  unsigned int st_uid;
+  unsigned int st_gid;
+  int __pad0;
+  unsigned long st_rdev;
+  long st_size;
+  long st_blksize;
+  long st_blocks;
+  struct timespec st_atim;
+  struct timespec st_mtim;
+  struct timespec st_ctim;
+  long __glibc_reserved[3];
+};
+#define S_ISREG(mode) (((mode) & 0170000) == 0100000)
+int fstat(int fd, struct stat *buf);
+
+#define PROT_READ 0x1
+#define PROT_WRITE 0x2
+#define MAP_PRIVATE 0x02
+#define MAP_FIXED 0x10
+#define MAP_ANONYMOUS 0x20
+#define MAP_FAILED ((void *)-1)
+void *mmap(void *addr, size_t length, int prot, int flags, int fd,
+           long offset);
+int munmap(void *addr, size_t length);
+
+typedef long ssize_t;
+struct iovec
+{
+  void *iov_base;
+  size_t iov_len;
+};
+#define O_RDONLY 00
+#define O_WRONLY 01
+#define O_CREAT 0100
+#define O_TRUNC 01000
+#define O_APPEND 02000
+#define EINTR 4
+#define EEXIST 17
+int open(char *pathname, int flags, ...);
+int close(int fd);
+int dup(int oldfd);
+int dup2(int oldfd, int newfd);
+ssize_t write(int fd, void *buf, size_t count);
+ssize_t writev(int fd, struct iovec *iov, int iovcnt);
+int mkdir(char *pathname, unsigned int mode);
+int rename(char *oldpath, char *newpath);
+int unlink(char *pathname);
+int getpid();
+
+typedef struct __dirstream DIR;
+struct dirent
+{
+  unsigned long d_ino;
+  long d_off;
+  unsigned short d_reclen;
+  unsigned char d_type;
+  char d_name[256];
+};
+DIR *opendir(char *name);
+struct dirent *readdir(DIR *dirp);
+int closedir(DIR *dirp);
+
+#define CLOCK_MONOTONIC 1
+int clock_gettime(int clockid, struct timespec *tp);
+
 #endif
\ No newline at end of file
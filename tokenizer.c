@@ -9,6 +9,7 @@
 #include <ctype.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #endif
@@ -18,14 +19,122 @@
 #include "include/preprocessor.h"
 #include "include/vector.h"
 
+// Character classes used by the lexer
+#define CC_SPACE 1  // Whitespace other than '\n'
+#define CC_IDENT 2  // Alphanumeric and '_'
+#define CC_PUNCT 4  // First character of a punctuator
+
+#define SP CC_SPACE
+#define ID CC_IDENT
+#define PU CC_PUNCT
+static const uint8_t char_class[256] = {
+    // 0x00: \t \v \f \r
+    0, 0, 0, 0, 0, 0, 0, 0, 0, SP, 0, SP, SP, SP, 0, 0,
+    // 0x10
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    // 0x20: (space) ! " # $ % & ' ( ) * + , - . /
+    SP, PU, 0, 0, 0, PU, PU, 0, PU, PU, PU, PU, PU, PU, PU, PU,
+    // 0x30: 0-9 : ; < = > ?
+    ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, PU, PU, PU, PU, PU, PU,
+    // 0x40: @ A-O
+    0, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID,
+    // 0x50: P-Z [ \ ] ^ _
+    ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, PU, PU, PU, PU, ID,
+    // 0x60: ` a-o
+    0, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID,
+    // 0x70: p-z { | } ~ DEL
+    ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, PU, PU, PU, PU, 0,
+    // 0x80-0xff: 0
+};
+#undef SP
+#undef ID
+#undef PU
+
+// Word-at-a-time (SWAR) helpers for scanning long runs of bytes.
+// Words are only loaded from 8-byte aligned addresses, so a load never
+// crosses a page boundary past the terminating byte of the buffer.
+#define SWAR_ONES 0x0101010101010101UL
+#define SWAR_HIGHS 0x8080808080808080UL
+
+static uint64_t swar_load(char *p)
+{
+  uint64_t word;
+  memcpy(&word, p, sizeof(word));
+  return word;
+}
+
+// Nonzero if any byte of the word is equal to c
+static uint64_t swar_has_byte(uint64_t word, char c)
+{
+  uint64_t x = word ^ (SWAR_ONES * (uint8_t)c);
+  return (x - SWAR_ONES) & ~x & SWAR_HIGHS;
+}
+
+// Return the first position at or after p holding a, b, c or '\0'
+static char *scan_until(char *p, char a, char b, char c)
+{
+  for (;;)
+  {
+    if (!((uintptr_t)p & 7))
+    {
+      uint64_t word = swar_load(p);
+      while (!(swar_has_byte(word, a) | swar_has_byte(word, b) |
+               swar_has_byte(word, c) | swar_has_byte(word, '\0')))
+        word = swar_load(p += 8);
+    }
+    if (*p == a || *p == b || *p == c || *p == '\0')
+      return p;
+    p++;
+  }
+}
+
+// Skip whitespace other than '\n'; runs of ' ' are skipped 8 bytes at a time
+static char *skip_space(char *p)
+{
+  for (;;)
+  {
+    if (!((uintptr_t)p & 7))
+      while (swar_load(p) == SWAR_ONES * ' ')
+        p += 8;
+    if (!(char_class[(uint8_t)*p] & CC_SPACE))
+      return p;
+    p++;
+  }
+}
+
 Token *token_head;
 Token *token;      // The actual token
 Token *token_old;  // The token after token
 
+// Significant tokens (all but TK_IGNORABLE, TK_ILB and TK_LINEBREAK) from
+// token_head, built by index_tokens(). The parser cursor is token_pos.
+static Token **token_array;
+static size_t token_array_size;
+static size_t token_pos;
+
 const char *tokenkindlist[TK_END] = {TokenKindTable};
+char *keywordlist[KW_END] = {KeywordTable};
 
-void fix_token_head()
+// Register every keyword in the atom table
+void init_keywords()
 {
+  for (Keyword keyword = KW_NONE + 1; keyword < KW_END; keyword++)
+    atom_intern(keywordlist[keyword], strlen(keywordlist[keyword]))
+        ->keyword = keyword;
+}
+
+// Return the keyword the token spells, or KW_NONE
+Keyword token_keyword(Token *token)
+{
+  if (!token->atom)
+    return KW_NONE;
+  return token->atom->keyword;
+}
+
+// Sets the token head to the first significant token from head
+void fix_token_head(Token *head)
+{
+  token = head;
   while (token->kind == TK_IGNORABLE || token->kind == TK_ILB ||
          token->kind == TK_LINEBREAK || token->kind == TK_EOF)
   {
@@ -41,26 +150,48 @@ Token *get_token_head()
   return token_head;
 }
 
+// Collect the significant tokens from token_head into token_array so that
+// the parser can advance, look ahead and rewind in O(1).
+// Must be called after fix_token_head().
+void index_tokens()
+{
+  size_t capacity = 1024;
+  token_array = malloc(capacity * sizeof(Token *));
+  token_array_size = 0;
+  for (Token *ptr = token_head; ptr; ptr = ptr->next)
+  {
+    if (ptr->kind == TK_IGNORABLE || ptr->kind == TK_ILB ||
+        ptr->kind == TK_LINEBREAK)
+      continue;
+    if (token_array_size == capacity)
+      token_array = realloc(token_array, (capacity *= 2) * sizeof(Token *));
+    token_array[token_array_size++] = ptr;
+  }
+  token_pos = 0;
+  token = token_array[0];
+}
+
 // Advance the token, ignoring TK_IGNORABLE, TK_LIB, and TK_LINEBREAK
 Token *token_next()
 {
   token_old = token;
-  do
-  {
-    // if (token->kind != TK_IGNORABLE && token->kind != TK_ILB &&
-    //     token->kind != TK_LINEBREAK)
-    //   token_old = token;
-    token = token->next;
-  } while (token->kind == TK_IGNORABLE || token->kind == TK_ILB ||
-           token->kind == TK_LINEBREAK);
+  if (token_pos + 1 < token_array_size)
+    token = token_array[++token_pos];
   return token_old;
 }
 
-// Change the position of the token to the position of the argument
-// Use with caution as it is quite dangerous
-void set_token(Token *next)
+// Get the position of the current token, to be restored by
+// set_token_position()
+size_t get_token_position()
+{
+  return token_pos;
+}
+
+// Rewind (or advance) the current token to the argument position
+void set_token_position(size_t position)
 {
-  token = next;
+  token_pos = position;
+  token = token_array[position];
 }
 
 Token *get_token()
@@ -73,12 +204,9 @@ Token *get_token()
 // NULL.
 Token *consume_token_if_next_matches(TokenKind kind, char reserved)
 {
-  Token *next = token;
-  do
-  {
-    next = next->next;
-  } while (next->kind == TK_IGNORABLE || next->kind == TK_ILB ||
-           next->kind == TK_LINEBREAK);
+  if (token_pos + 1 >= token_array_size)
+    return NULL;
+  Token *next = token_array[token_pos + 1];
   if (token->kind == kind && next->kind == TK_RESERVED &&
       next->str[0] == reserved)
     return token_next();
@@ -111,6 +239,32 @@ Token *expect(char *op, TokenKind kind)
   return result;
 }
 
+// If the next token is the argument keyword, return it. Otherwise, return NULL.
+Token *peek_keyword(Keyword keyword)
+{
+  if (token_keyword(token) != keyword)
+    return NULL;
+  return token;
+}
+
+// If the next token is the argument keyword, read it. Otherwise, return NULL.
+Token *consume_keyword(Keyword keyword)
+{
+  if (peek_keyword(keyword))
+    return token_next();
+  return NULL;
+}
+
+// If the next token is the argument keyword, read it. Otherwise, call
+// error_at.
+Token *expect_keyword(Keyword keyword)
+{
+  Token *result = consume_keyword(keyword);
+  if (!result)
+    error_at(token->str, token->len, "Token is not %s.", keywordlist[keyword]);
+  return result;
+}
+
 // Get the previous token
 Token *get_old_token()
 {
@@ -119,8 +273,7 @@ Token *get_old_token()
 
 Token *peek_ident()
 {
-  long long tmp;
-  if (token->kind != TK_IDENT || is_number(&tmp))
+  if (token->kind != TK_IDENT || isdigit(token->str[0]))
     return NULL;
   return token;
 }
@@ -160,7 +313,7 @@ Token *consume_string()
   }
   // replace \e to \x1b
   if (return_token)
-    for (size_t i = 0; i < return_token->len - 1; i++)
+    for (size_t i = 0; i + 1 < return_token->len; i++)
     {
       if (*(return_token->str + i) == '\\' &&
           *(return_token->str + i + 1) == 'e')
@@ -185,21 +338,104 @@ Token *consume_char()
   return NULL;
 }
 
-bool is_number(long long *result)
+// Decode the atom as an integer constant: decimal, octal (0), hexadecimal
+// (0x) or binary (0b) digits followed by an optional u/U and l/L or ll/LL
+// suffix in either order.
+static void decode_number(Atom *atom)
 {
-  if (token->kind != TK_IDENT || !isdigit(token->str[0]))
+  char *p = atom->str;
+  uint8_t base = 10;
+  if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+  {
+    base = 16;
+    p += 2;
+  }
+  else if (p[0] == '0' && (p[1] == 'b' || p[1] == 'B'))
+  {
+    base = 2;
+    p += 2;
+  }
+  else if (p[0] == '0')
+    base = 8;
+  atom->number_base = base;
+  atom->is_number = false;
+
+  char *digits = p;
+  unsigned long long value = 0;
+  for (;; p++)
+  {
+    int digit;
+    if ('0' <= *p && *p <= '9')
+      digit = *p - '0';
+    else if ('a' <= *p && *p <= 'f')
+      digit = *p - 'a' + 10;
+    else if ('A' <= *p && *p <= 'F')
+      digit = *p - 'A' + 10;
+    else
+      break;
+    if (digit >= base)
+      break;
+    value = value * base + digit;
+  }
+  if (p == digits)
+    return;
+
+  uint8_t suffix = 0;
+  if (*p == 'u' || *p == 'U')
+  {
+    suffix |= NUMBER_UNSIGNED;
+    p++;
+  }
+  if ((p[0] == 'l' && p[1] == 'l') || (p[0] == 'L' && p[1] == 'L'))
+  {
+    suffix |= NUMBER_LONGLONG;
+    p += 2;
+  }
+  else if (*p == 'l' || *p == 'L')
+  {
+    suffix |= NUMBER_LONG;
+    p++;
+  }
+  if (!(suffix & NUMBER_UNSIGNED) && (*p == 'u' || *p == 'U'))
+  {
+    suffix |= NUMBER_UNSIGNED;
+    p++;
+  }
+  if (p != atom->str + atom->len)
+    return;
+  atom->is_number = true;
+  atom->number_suffix = suffix;
+  atom->number_value = value;
+}
+
+// If the token is an integer constant, store its value and suffix (if they
+// are non-null) and return true. Otherwise, return false.
+bool token_number(Token *token, unsigned long long *value, uint8_t *suffix)
+{
+  Atom *atom = token->atom;
+  if (!atom || !isdigit(atom->str[0]))
     return false;
-  char *ptr;
-  *result = strtoll(token->str, &ptr, 10);
-  if (ptr - token->str != (int)token->len)
+  if (!atom->number_base)
+    decode_number(atom);
+  if (!atom->is_number)
     return false;
+  if (value)
+    *value = atom->number_value;
+  if (suffix)
+    *suffix = atom->number_suffix;
   return true;
 }
 
-// If the next token is an integer, read it. Otherwise, return an error.
-bool consume_number(long long *value)
+bool is_number(unsigned long long *value, uint8_t *suffix)
 {
-  if (!is_number(value))
+  return token_number(token, value, suffix);
+}
+
+// If the next token is an integer, read its value and suffix. Otherwise,
+// return false.
+bool consume_number(unsigned long long *value, uint8_t *suffix)
+{
+  if (!is_number(value, suffix))
     return false;
   token_next();
   return true;
@@ -214,205 +450,358 @@ bool at_eof()
 // Whether the given argument constitutes a token (alphanumeric and '_')
 int is_alnum(char c)
 {
-  return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') ||
-         ('0' <= c && c <= '9') || (c == '_');
+  return char_class[(uint8_t)c] & CC_IDENT;
 }
 
-// Function to create a new token
-Token *new_token(TokenKind kind, char *str)
+// Tokens are carved out of large zero-filled chunks instead of being
+// allocated one by one. All of them stay alive until token_arena_free()
+// releases the whole translation unit at once.
+#define TOKEN_CHUNK_SIZE 4096
+
+typedef struct TokenChunk TokenChunk;
+
+struct TokenChunk
 {
-  Token *new = calloc(1, sizeof(Token));
-  new->kind = kind;
-  new->str = str;
-  return new;
-}
+  TokenChunk *next;  // Previously filled chunk
+  size_t used;       // Number of tokens handed out from this chunk
+  Token tokens[TOKEN_CHUNK_SIZE];
+};
 
-Token *tokenize_once(char *input, char **end)
+static TokenChunk *token_chunk;
+
+// Allocate a zero-cleared token from the arena
+Token *token_alloc()
 {
-  Token *cur;
-  // Newline: isspace also processes '\n', so place it before that.
-  if (*input == '\n')
+  if (!token_chunk || token_chunk->used == TOKEN_CHUNK_SIZE)
   {
-    cur = new_token(TK_LINEBREAK, input++);
-    cur->len = 1;
-    *end = input;
-    return cur;
+    TokenChunk *new = calloc(1, sizeof(TokenChunk));
+    new->next = token_chunk;
+    token_chunk = new;
   }
+  return &token_chunk->tokens[token_chunk->used++];
+}
+
+// The hide sets of the tokens made by macro expansions (see define.c). Most
+// tokens come straight from the source, so they are kept in an open
+// addressing table keyed by the token instead of in every token.
+typedef struct
+{
+  Token *token;  // NULL if the slot is empty
+  HideSet *hide_set;
+} HideSetSlot;
+
+static HideSetSlot *hide_set_table;
+static size_t hide_set_table_size;  // Number of slots, a power of two
+static size_t hide_set_table_used;
+
+static size_t hide_set_slot(Token *token)
+{
+  size_t hash = (uintptr_t)token / sizeof(Token) * 0x9E3779B97F4A7C15ULL;
+  size_t i = hash >> 32 & (hide_set_table_size - 1);
+  while (hide_set_table[i].token && hide_set_table[i].token != token)
+    i = (i + 1) & (hide_set_table_size - 1);
+  return i;
+}
 
-  size_t space_counter = 0;
-  while (isspace(*input) && *input != '\n')
+// Return the hide set of token, NULL if it was not made by a macro
+HideSet *token_hide_set(Token *token)
+{
+  if (!hide_set_table_used)
+    return NULL;
+  return hide_set_table[hide_set_slot(token)].hide_set;
+}
+
+void token_set_hide_set(Token *token, HideSet *hide_set)
+{
+  if ((hide_set_table_used + 1) * 2 > hide_set_table_size)
   {
-    space_counter++;
-    input++;
+    HideSetSlot *old = hide_set_table;
+    size_t old_size = hide_set_table_size;
+    hide_set_table_size = old_size ? old_size * 2 : 1024;
+    hide_set_table = calloc(hide_set_table_size, sizeof(HideSetSlot));
+    for (size_t i = 0; i < old_size; i++)
+      if (old[i].token)
+        hide_set_table[hide_set_slot(old[i].token)] = old[i];
+    free(old);
   }
-  if (space_counter)
+  HideSetSlot *slot = &hide_set_table[hide_set_slot(token)];
+  if (!slot->token)
   {
-    cur = new_token(TK_IGNORABLE, input - space_counter);
-    cur->len = space_counter;
-    *end = input;
-    return cur;
+    slot->token = token;
+    hide_set_table_used++;
   }
+  slot->hide_set = hide_set;
+}
+
+// Forget every hide set. The preprocessor does it at each line break outside
+// of macro invocations, as all the tokens made by macros are behind it then.
+void token_hide_sets_clear()
+{
+  if (!hide_set_table_used)
+    return;
+  memset(hide_set_table, 0, hide_set_table_size * sizeof(HideSetSlot));
+  hide_set_table_used = 0;
+}
+
+// Allocate a copy of the argument token from the arena
+Token *token_copy(Token *token)
+{
+  Token *new = token_alloc();
+  memcpy(new, token, sizeof(Token));
+  HideSet *hide_set = token_hide_set(token);
+  if (hide_set)
+    token_set_hide_set(new, hide_set);
+  return new;
+}
 
-  // Skip comments
-  if (!strncmp(input, "//", 2))
+// Release every token at once
+void token_arena_free()
+{
+  while (token_chunk)
   {
-    input++;
-    size_t i = 2;
-    while (*++input != '\n')
-      i++;
-    cur = new_token(TK_IGNORABLE, input - i);
-    cur->len = i;
-    *end = input;
-    return cur;
+    TokenChunk *next = token_chunk->next;
+    free(token_chunk);
+    token_chunk = next;
+  }
+  free(hide_set_table);
+  hide_set_table = NULL;
+  hide_set_table_size = 0;
+  hide_set_table_used = 0;
+}
+
+// Function to create a new token
+Token *new_token(TokenKind kind, char *str)
+{
+  Token *new = token_alloc();
+  new->kind = kind;
+  new->str = str;
+  return new;
+}
+
+// Return the length of the punctuator starting at p
+static size_t punctuator_len(char *p)
+{
+  switch (*p)
+  {
+    case '<':
+    case '>':  // < <= << <<= > >= >> >>=
+      if (p[1] == *p)
+        return p[2] == '=' ? 3 : 2;
+      return p[1] == '=' ? 2 : 1;
+    case '.':  // . ...
+      return p[1] == '.' && p[2] == '.' ? 3 : 1;
+    case '+':  // + ++ +=
+    case '&':  // & && &=
+    case '|':  // | || |=
+      return p[1] == *p || p[1] == '=' ? 2 : 1;
+    case '-':  // - -- -= ->
+      return p[1] == '-' || p[1] == '=' || p[1] == '>' ? 2 : 1;
+    case '=':
+    case '!':
+    case '*':
+    case '/':
+    case '%':
+    case '^':  // op op=
+      return p[1] == '=' ? 2 : 1;
+    default: return 1;
   }
-  if (!strncmp(input, "/*", 2))
+}
+
+// Whether lhs and rhs would be read as other tokens if they were written
+// without a space between them
+bool tokens_would_paste(Token *lhs, Token *rhs)
+{
+  if (lhs->kind == TK_IDENT)
+    return rhs->kind == TK_IDENT;
+  if ((lhs->kind != TK_RESERVED && lhs->kind != TK_DIRECTIVE) ||
+      (rhs->kind != TK_RESERVED && rhs->kind != TK_DIRECTIVE))
+    return false;
+  if (lhs->len == 1 && lhs->str[0] == '/' &&
+      (rhs->str[0] == '/' || rhs->str[0] == '*'))
+    return true;  // a comment
+  if (lhs->len == 1 && lhs->str[0] == '#' && rhs->str[0] == '#')
+    return true;
+  char spelling[4] = {0};  // a punctuator has at most 3 characters
+  memcpy(spelling, lhs->str, lhs->len);
+  spelling[lhs->len] = rhs->str[0];
+  return punctuator_len(spelling) > lhs->len;
+}
+
+Token *tokenize_once(char *input, char **end)
+{
+  Token *cur;
+  char *pointer;
+  switch (*input)
   {
-    char *comment_end = strstr(input + 2, "*/");
-    if (!comment_end)
-      error_at(input, 1, "Comment is not closed.");
-    cur = new_token(TK_IGNORABLE, input);
-    char *pointer = input;
-    while (pointer <= comment_end)
-    {
-      if (*++pointer == '\n')
+    case '\n':
+      cur = new_token(TK_LINEBREAK, input);
+      cur->len = 1;
+      *end = input + 1;
+      return cur;
+
+    case '#':
+      cur = new_token(TK_DIRECTIVE, input);
+      cur->len = 1;
+      *end = input + 1;
+      return cur;
+
+    case '/':
+      // Skip comments
+      if (input[1] == '/')
       {
+        pointer = scan_until(input + 2, '\n', '\n', '\n');
+        cur = new_token(TK_IGNORABLE, input);
         cur->len = pointer - input;
-        cur = new_token(TK_LINEBREAK, pointer);
-        cur->len = 1;
-        cur = new_token(TK_IGNORABLE, pointer);
-        input = pointer;
+        *end = pointer;
+        return cur;
       }
-    }
-    cur->len = comment_end + 2 - input;
-    *end = comment_end + 2;
-    return cur;
-  }
+      if (input[1] == '*')
+      {
+        // The token returned starts at the last line break in the comment
+        char *start = input;
+        pointer = input + 2;
+        for (;;)
+        {
+          pointer = scan_until(pointer, '*', '\n', '\n');
+          if (!*pointer)
+            error_at(input, 1, "Comment is not closed.");
+          if (*pointer == '\n')
+            start = pointer;
+          else if (pointer[1] == '/')
+            break;
+          pointer++;
+        }
+        cur = new_token(TK_IGNORABLE, start);
+        cur->len = pointer + 2 - start;
+        *end = pointer + 2;
+        return cur;
+      }
+      break;
 
-  if (*input == '#')
-  {
-    cur = new_token(TK_DIRECTIVE, input);
-    cur->len = 1;
-    *end = input + 1;
-    return cur;
-  }
+    case '\\':
+      if (input[1] == '\n')
+      {
+        cur = new_token(TK_ILB, input);
+        cur->len = 2;
+        *end = input + 2;
+        return cur;
+      }
+      break;
 
-  if (strchr("+-*/()=!<>;{},&[].\\|%?:~^", *input))
-  {
-    if (*input == '\\' && *(input + 1) == '\n')
-    {
-      cur = new_token(TK_ILB, input);
-      cur->len = 2;
-      input += 2;
-      *end = input;
+    case '"':
+      // String detection (the token excludes the quotes)
+      pointer = input + 1;
+      for (;;)
+      {
+        pointer = scan_until(pointer, '"', '\\', '\n');
+        if (*pointer == '"')
+          break;
+        if (*pointer != '\\' || !pointer[1])
+          error_at(input, 1, "String is not closed.");
+        pointer += 2;  // Skip the escaped character
+      }
+      cur = new_token(TK_STRING, input + 1);
+      cur->len = pointer - input - 1;
+      *end = pointer + 1;
       return cur;
-    }
-    cur = new_token(TK_RESERVED, input);
-    // For "==", "<=", ">=", "!=", "&&", "||", "->", "++", "--", "*=", "/=",
-    // "%=",
-    // "+=", "-=", "<<=", ">>=", "&=", "^=", "|="
-    if ((*(input + 2) == '=' && ((*(input + 1) == '<' && *(input) == '<') ||
-                                 (*(input + 1) == '>' && *(input) == '>'))) ||
-        (*(input + 2) == '.' && *(input + 1) == '.' && *input == '.'))
-    {
-      pr_debug2("find RESERVED token: %.3s", input);
-      cur->len = 3;
-      input += 3;
-    }
-    else if ((*(input + 1) == '=' &&
-              (*input == '<' || *input == '>' || *input == '!' ||
-               *input == '=' || *input == '*' || *input == '/' ||
-               *input == '%' || *input == '+' || *input == '-' ||
-               *input == '&' || *input == '^' || *input == '|')) ||
-             (*(input + 1) == '>' && *input == '>') ||
-             (*(input + 1) == '<' && *input == '<') ||
-             (*(input + 1) == '&' && *input == '&') ||
-             (*(input + 1) == '|' && *input == '|') ||
-             (*(input + 1) == '+' && *input == '+') ||
-             (*(input + 1) == '-' && *input == '-') ||
-             (*(input + 1) == '>' && *input == '-'))
-    {
-      pr_debug2("find RESERVED token: %.2s", input);
-      cur->len = 2;
-      input += 2;
-    }
-    else
-    {
-      pr_debug2("find RESERVED token: %.1s", input);
+
+    case '\'':
+      // Character detection
+      input++;  // Skip opening quote
+      cur = new_token(TK_CHAR, input);
       cur->len = 1;
-      input++;
-    }
-    *end = input;
-    return cur;
+      if (*input++ == '\\')
+      {  // Handle escape sequences
+        input++;
+        cur->len = 2;
+        if (!(*input == 'n' || *input == 't' || *input == '\\' ||
+              *input == '\'' || *input == '"' || *input == '0'))
+          error_at(input, 1, "Unknown escape sequence.");
+      }
+      if (*input != '\'')
+      {
+        error_at(input, 1, "Unterminated character literal.");
+      }
+      input++;  // Skip closing quote
+      *end = input;
+      return cur;
+
+    default: break;
   }
 
-  // String detection
-  if (*input == '"')
+  uint8_t class = char_class[(uint8_t)*input];
+  if (class & CC_SPACE)
   {
-    int i = 0;  // Size of the string (excluding ")
-    do
-    {
-      while (*(++input) != '"')
-        i++;
-      i++;
-    } while (*(input - 1) == '\\');
-    input++;  // Advance to the end
-    cur = new_token(TK_STRING, input - i);
-    cur->len = i - 1;
-    *end = input;
+    pointer = skip_space(input);
+    cur = new_token(TK_IGNORABLE, input);
+    cur->len = pointer - input;
+    *end = pointer;
     return cur;
   }
 
-  // Character detection
-  if (*input == '\'')
+  if (class & CC_PUNCT)
   {
-    input++;  // Skip opening quote
-    cur = new_token(TK_CHAR, input);
-    cur->str = input;
-    cur->len = 1;
-    if (*input++ == '\\')
-    {  // Handle escape sequences
-      input++;
-      cur->len = 2;
-      if (!(*input == 'n' || *input == 't' || *input == '\\' ||
-            *input == '\'' || *input == '"' || *input == '0'))
-        error_at(input, 1, "Unknown escape sequence.");
-    }
-    if (*input != '\'')
-    {
-      error_at(input, 1, "Unterminated character literal.");
-    }
-    input++;  // Skip closing quote
-    *end = input;
+    cur = new_token(TK_RESERVED, input);
+    cur->len = punctuator_len(input);
+    pr_debug2("find RESERVED token: %.*s", (int)cur->len, input);
+    *end = input + cur->len;
     return cur;
   }
 
   // If it's only alphanumeric and '_', consider it a variable or reserved
   // word
-  int i = 0;
-  while (is_alnum(*input))
+  if (class & CC_IDENT)
   {
-    i++;
-    input++;
-  }
-  if (i)
-  {
-    cur = new_token(TK_IDENT, input - i);
-    cur->len = i;
-    *end = input;
+    pointer = input;
+    while (char_class[(uint8_t)*++pointer] & CC_IDENT)
+      ;
+    cur = new_token(TK_IDENT, input);
+    cur->len = pointer - input;
+    cur->atom = atom_intern(input, cur->len);
+    if ('0' <= *input && *input <= '9')
+      token_number(cur, NULL, NULL);  // decode the integer constant once
+    *end = pointer;
     return cur;
   }
   error_at(input, 1, "Failed to tokenize.");
   return NULL;
 }
 
-// Function to tokenize
-Token *tokenizer(char *input, char *end, Token *next_token)
+// Whether the directive name at input (after '#') starts a group that the
+// preprocessor may skip: #if, #ifdef, #ifndef, #elif, #elifdef, #elifndef
+// and #else
+static bool is_group_directive(char *input)
+{
+  input = skip_space(input);
+  char *name = input;
+  while (is_alnum(*input))
+    input++;
+  switch (input - name)
+  {
+    case 2: return !strncmp(name, "if", 2);
+    case 4: return !strncmp(name, "elif", 4) || !strncmp(name, "else", 4);
+    case 5: return !strncmp(name, "ifdef", 5);
+    case 6: return !strncmp(name, "ifndef", 6);
+    case 7: return !strncmp(name, "elifdef", 7);
+    case 8: return !strncmp(name, "elifndef", 8);
+    default: return false;
+  }
+}
+
+// Tokenize input up to end (up to '\0' if end is NULL).
+// Tokenization stops after the line of a directive that starts a group
+// (#if, #else etc.), since the preprocessor may skip the group without
+// tokenizing it (see skip_conditional_group()). In that case the next of the
+// last token is NULL and *rest points to the beginning of the next line.
+// Otherwise the tokens end with TK_EOF followed by next_token and *rest is
+// NULL.
+static Token *tokenize_group(char *input, char *end, Token *next_token,
+                             char **rest)
 {
-  pr_debug("start tokenizer...");
   Token head;
   head.next = NULL;
   Token *cur = &head;
-  Vector *nest_list = vector_new();
+  bool is_group_line = false;
   while (end ? input != end : *input)
   {
     char *end = NULL;
@@ -420,46 +809,161 @@ Token *tokenizer(char *input, char *end, Token *next_token)
     input = end;
     cur = cur->next;
 
-    if (cur->kind == TK_DIRECTIVE)
+    if (cur->kind == TK_DIRECTIVE && is_group_directive(input))
+      is_group_line = true;
+    else if (cur->kind == TK_LINEBREAK && is_group_line)
     {
-      size_t counter = 0;
-      char *tmp = input;
-      while (isspace(*tmp) && *tmp != '\n')
-        tmp++;
-      while (is_alnum(*tmp))
-      {
-        counter++;
-        tmp++;
-      }
-      // Conditional_Inclusion (#if #endif etc.) to speed up
-      if ((counter == 2 && !strncmp(tmp - counter, "if", 2)) ||
-          (counter == 5 && !strncmp(tmp - counter, "ifdef", 5)) ||
-          (counter == 6 && !strncmp(tmp - counter, "ifndef", 6)))
-      {
-        Vector *new = vector_new();
-        vector_push(Conditional_Inclusion_List, new);
-        vector_push(nest_list, new);
-        vector_push(new, cur);
-      }
-      else if ((counter == 4 && (!strncmp(tmp - counter, "else", 4) ||
-                                 !strncmp(tmp - counter, "elif", 4))) ||
-               (counter == 7 && !strncmp(tmp - counter, "elifdef", 7)) ||
-               (counter == 8 && !strncmp(tmp - counter, "elifndef", 8)))
-        vector_push(vector_peek(nest_list), cur);
-      else if (counter == 5 && !strncmp(tmp - counter, "endif", 5))
-        vector_push(vector_pop(nest_list), cur);
+      *rest = input;
+      return head.next;
     }
   }
 
   cur->next = new_token(TK_EOF, input);
   cur->next->next = next_token;
+  *rest = NULL;
+  return head.next;
+}
 
+// Function to tokenize
+// Tokenizes the beginning of the file, see tokenize_group() for rest
+Token *tokenizer(char *input, char *end, Token *next_token, char **rest)
+{
+  pr_debug("start tokenizer...");
+  Token *head = tokenize_group(input, end, next_token, rest);
   pr_debug("Tokenization complete.");
-  vector_free(nest_list);
 #ifdef DEBUG
-  print_tokenize_result(head.next);
+  print_tokenize_result(head);
 #endif
 
-  token = head.next;
+  token = head;
   return token;
+}
+
+// Tokenize the part of the file following a group directive, which
+// tokenizer() or tokenize_rest() stopped at
+Token *tokenize_rest(char **rest, char *end, Token *next_token)
+{
+  return tokenize_group(*rest, end, next_token, rest);
+}
+
+// Skip the false group starting at input (the line following #if, #else
+// etc.) as raw text, without tokenizing it.
+// Only line-leading directives are looked at, so that the nested groups and
+// the #elif, #else or #endif closing the group are found. Comments and
+// string literals are passed over so that a '#' inside them is not taken as a
+// directive. Line breaks are returned as TK_LINEBREAK tokens to keep the line
+// count, and *rest is set to the beginning of the line of the closing
+// directive.
+Token *skip_conditional_group(char *input, char *end, char **rest)
+{
+  Token head;
+  head.next = NULL;
+  Token *cur = &head;
+  size_t depth = 0;
+  bool in_comment = false;
+  for (;;)
+  {
+    char *line = input;
+    if (!in_comment)
+    {
+      // A comment before '#' is only a space (C11 5.1.1.2)
+      for (input = skip_space(input); input[0] == '/' && input[1] == '*';
+           input = skip_space(input + 2))
+      {
+        for (input += 2; input[0] != '*' || input[1] != '/'; input++)
+        {
+          if (end ? input >= end : !*input)
+            error_exit("#if directive is not closed.");
+          if (*input == '\n')
+          {
+            cur = cur->next = new_token(TK_LINEBREAK, input);
+            cur->len = 1;
+          }
+        }
+        line = input + 2;  // its line breaks have been counted
+      }
+      if (*input == '#' && (!end || input != end))
+      {
+        input = skip_space(input + 1);
+        char *name = input;
+        while (is_alnum(*input))
+          input++;
+        size_t len = input - name;
+        if ((len == 2 && !strncmp(name, "if", 2)) ||
+            (len == 5 && !strncmp(name, "ifdef", 5)) ||
+            (len == 6 && !strncmp(name, "ifndef", 6)))
+          depth++;
+        else if (len == 5 && !strncmp(name, "endif", 5))
+        {
+          if (!depth)
+          {
+            *rest = line;
+            return head.next;
+          }
+          depth--;
+        }
+        else if (!depth && is_group_directive(name))
+        {
+          *rest = line;
+          return head.next;
+        }
+      }
+    }
+
+    // Go to the end of the line
+    for (;; input++)
+    {
+      if (end ? input >= end : !*input)
+        error_exit("#if directive is not closed.");
+      if (*input == '\n')
+        break;
+      if (in_comment)
+      {
+        if (input[0] == '*' && input[1] == '/')
+        {
+          in_comment = false;
+          input++;
+        }
+        continue;
+      }
+      switch (*input)
+      {
+        case '\\':
+          if (input[1] == '\n')  // the line continues, but is still counted
+          {
+            input++;
+            cur = cur->next = new_token(TK_LINEBREAK, input);
+            cur->len = 1;
+          }
+          break;
+        case '/':
+          if (input[1] == '*')
+          {
+            in_comment = true;
+            input++;
+          }
+          else if (input[1] == '/')
+            input = scan_until(input, '\n', '\n', '\n') - 1;
+          break;
+        case '"':
+        case '\'':
+        {
+          char quote = *input;
+          while (input[1] && input[1] != quote && input[1] != '\n')
+          {
+            if (input[1] == '\\' && input[2] && input[2] != '\n')
+              input++;
+            input++;
+          }
+          if (input[1] == quote)
+            input++;
+        }
+        break;
+        default: break;
+      }
+    }
+    cur = cur->next = new_token(TK_LINEBREAK, input);
+    cur->len = 1;
+    input++;
+  }
 }
\ No newline at end of file
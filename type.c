@@ -9,33 +9,198 @@
 #else
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #endif
 
 #include "include/analyzer.h"
+#include "include/atom.h"
 #include "include/error.h"
 #include "include/eval_constant.h"
 #include "include/parser.h"
+#include "include/pch.h"
 #include "include/tokenizer.h"
 #include "include/vector.h"
 
 static Vector* OrdinaryNamespaceList;  // variable names, function names,
-                                       // enumeration member names
+                                       // enumeration member names declared in
+                                       // each nested scope
 static Vector* TagNamespaceList;       // struct, union, enumeration tag names
 static size_t tag_id;  // number assigned to struct, union, enumeration
 static Vector*
     EnumStructList;  // list of structs, unions, enumerations in order of tag_id
 static Vector* StringList;
 
-typedef struct
+typedef struct ordinary_data_list ordinary_data_list;
+struct ordinary_data_list
 {
   enum member_name ordinary_kind;
   Token* name;
   Type* type;
-  size_t enum_number;  // used for enums
-  Var* variables;      // used for variables
-  bool is_defined;     // used for functions
-} ordinary_data_list;
+  size_t enum_number;            // used for enums
+  Var* variables;                // used for variables
+  bool is_defined;               // used for functions
+  size_t depth;                  // nest of the declaring scope, 1 is file scope
+  ordinary_data_list* shadowed;  // previous declaration of the same name
+};
+
+// Names are looked up through a hash table keyed on the atom, holding both
+// the ordinary declarations and the tags of each name.
+// The declarations of a name are kept from the innermost scope out, and in
+// declaration order within a scope, so the first one is the one a scan of the
+// scopes from the innermost out would find.
+#define NAME_TABLE_SIZE 4096
+
+typedef struct scoped_name scoped_name;
+struct scoped_name
+{
+  scoped_name* next;  // Next name in the same hash bucket
+  Atom* atom;
+  ordinary_data_list* declarations;
+  tag_list* tags;
+};
+
+static scoped_name* name_table[NAME_TABLE_SIZE];
+
+static scoped_name* get_scoped_name(Atom* atom)
+{
+  scoped_name** bucket = &name_table[atom->hash & (NAME_TABLE_SIZE - 1)];
+  for (scoped_name* name = *bucket; name; name = name->next)
+    if (name->atom == atom)
+      return name;
+  scoped_name* name = calloc(1, sizeof(scoped_name));
+  name->next = *bucket;
+  name->atom = atom;
+  *bucket = name;
+  return name;
+}
+
+static scoped_name* find_scoped_name(Token* token)
+{
+  if (!token || !token->atom)
+    return NULL;
+  for (scoped_name* name =
+           name_table[token->atom->hash & (NAME_TABLE_SIZE - 1)];
+       name; name = name->next)
+    if (name->atom == token->atom)
+      return name;
+  return NULL;
+}
+
+// Returns the innermost declaration of the name of token
+static ordinary_data_list* find_ordinary(Token* token)
+{
+  scoped_name* name = find_scoped_name(token);
+  return name ? name->declarations : NULL;
+}
+
+// Returns the innermost tag named token
+static tag_list* find_tag(Token* token)
+{
+  scoped_name* name = find_scoped_name(token);
+  return name ? name->tags : NULL;
+}
+
+// Declare data in the current scope
+static void add_ordinary(ordinary_data_list* data)
+{
+  size_t depth = vector_size(OrdinaryNamespaceList);
+  ordinary_data_list** link = &get_scoped_name(data->name->atom)->declarations;
+  while (*link && (*link)->depth == depth)
+    link = &(*link)->shadowed;
+  data->depth = depth;
+  data->shadowed = *link;
+  *link = data;
+  vector_push(vector_peek(OrdinaryNamespaceList), data);
+}
+
+// Declare tag in the current scope
+static void add_tag(tag_list* tag)
+{
+  tag->depth = vector_size(TagNamespaceList);
+  if (tag->name)
+  {
+    scoped_name* name = get_scoped_name(tag->name->atom);
+    tag->shadowed = name->tags;
+    name->tags = tag;
+  }
+  vector_push(vector_peek(TagNamespaceList), tag);
+}
+
+// Put member in the open addressed member index of tag, unless a member of the
+// same name is already there
+static void index_member(tag_list* tag, tag_data_list* member)
+{
+  size_t mask = tag->members_size - 1;
+  for (size_t i = member->name->atom->hash & mask; tag->members[i];
+       i = (i + 1) & mask)
+    if (tag->members[i]->name->atom == member->name->atom)
+      return;
+  for (size_t i = member->name->atom->hash & mask;; i = (i + 1) & mask)
+    if (!tag->members[i])
+    {
+      tag->members[i] = member;
+      return;
+    }
+}
+
+// Index the members of data_list placed offset bytes into tag, flattening the
+// anonymous structs and unions
+static void index_members(tag_list* tag, Vector* data_list, size_t offset)
+{
+  for (size_t i = 1; i <= vector_size(data_list); i++)
+  {
+    tag_data_list* member = vector_peek_at(data_list, i);
+    if (member->name)
+    {
+      tag_data_list* indexed = member;
+      if (offset)
+      {
+        indexed = malloc(sizeof(tag_data_list));
+        indexed->name = member->name;
+        indexed->type = member->type;
+        indexed->offset = offset + member->offset;
+      }
+      index_member(tag, indexed);
+    }
+    else if (member->type->type == TYPE_STRUCT)
+    {
+      tag_list* child = vector_peek_at(EnumStructList, member->type->type_num);
+      if (child->struct_size)
+        index_members(tag, child->data_list, offset + member->offset);
+    }
+  }
+}
+
+// Count the members index_members() would index at most
+static size_t count_members(Vector* data_list)
+{
+  size_t count = 0;
+  for (size_t i = 1; i <= vector_size(data_list); i++)
+  {
+    tag_data_list* member = vector_peek_at(data_list, i);
+    if (member->name)
+      count++;
+    else if (member->type->type == TYPE_STRUCT)
+    {
+      tag_list* child = vector_peek_at(EnumStructList, member->type->type_num);
+      if (child->struct_size)
+        count += count_members(child->data_list);
+    }
+  }
+  return count;
+}
+
+// Build the member index of a completed struct or union
+static void build_member_index(tag_list* tag)
+{
+  size_t size = 8;
+  while (size < count_members(tag->data_list) * 2)
+    size *= 2;
+  tag->members = calloc(size, sizeof(tag_data_list*));
+  tag->members_size = size;
+  index_members(tag, tag->data_list, 0);
+}
 
 // For debug use
 Token* print_struct_type(size_t tag_id)
@@ -55,51 +220,24 @@ Token* print_struct_type(size_t tag_id)
 
 static Type* find_typedef_type(Token* token)
 {
-  if (!token)
-    return NULL;
-  for (size_t i = vector_size(OrdinaryNamespaceList); i >= 1; i--)
-  {
-    Vector* typedef_nest = vector_peek_at(OrdinaryNamespaceList, i);
-    for (size_t j = 1; j <= vector_size(typedef_nest); j++)
-    {
-      ordinary_data_list* tmp = vector_peek_at(typedef_nest, j);
-      if (tmp->ordinary_kind == typedef_name && tmp->name &&
-          tmp->name->len == token->len &&
-          !strncmp(tmp->name->str, token->str, token->len))
-      {
-        return tmp->type;
-      }
-    }
-  }
+  for (ordinary_data_list* tmp = find_ordinary(token); tmp; tmp = tmp->shadowed)
+    if (tmp->ordinary_kind == typedef_name)
+      return tmp->type;
   return NULL;
 }
 
-static ordinary_data_list* find_var_in_current_nested_block(Token* token,
-                                                            size_t* data_num)
+static ordinary_data_list* find_var_in_current_nested_block(Token* token)
 {
-  for (size_t i = 1; i <= vector_size(vector_peek(OrdinaryNamespaceList)); i++)
-  {
-    ordinary_data_list* var =
-        vector_peek_at(vector_peek(OrdinaryNamespaceList), i);
-    if (var->name->len == token->len &&
-        !strncmp(var->name->str, token->str, token->len))
-    {
-      *data_num = i;
-      return var;
-    }
-  }
+  ordinary_data_list* var = find_ordinary(token);
+  if (var && var->depth == vector_size(OrdinaryNamespaceList))
+    return var;
   return NULL;
 }
 
 bool is_type_specifier(Token* token)
 {
-  if (peek("void", TK_IDENT) || peek("char", TK_IDENT) ||
-      peek("short", TK_IDENT) || peek("int", TK_IDENT) ||
-      peek("long", TK_IDENT) || peek("signed", TK_IDENT) ||
-      peek("unsigned", TK_IDENT) || peek("bool", TK_IDENT) ||
-      peek("_Bool", TK_IDENT) || peek("const", TK_IDENT) ||
-      peek("struct", TK_IDENT) || peek("union", TK_IDENT) ||
-      peek("enum", TK_IDENT))
+  Keyword keyword = token_keyword(token);
+  if (KW_VOID <= keyword && keyword <= KW_ENUM)
     return true;
 
   return find_typedef_type(token) != NULL;
@@ -141,86 +279,58 @@ Type* declaration_specifiers(uint8_t* storage_class_specifier)
     Token* token = get_token();
     bool consumed = false;
 
-    if (consume("typedef", TK_IDENT) && ASSERT_STORAGE_SPECIFIER &&
+    if (consume_keyword(KW_TYPEDEF) && ASSERT_STORAGE_SPECIFIER &&
         CONSUMED_TRUE)
       *storage_class_specifier = 1 << 0;
-    else if (consume("extern", TK_IDENT) && ASSERT_STORAGE_SPECIFIER &&
+    else if (consume_keyword(KW_EXTERN) && ASSERT_STORAGE_SPECIFIER &&
              CONSUMED_TRUE)
       *storage_class_specifier = 1 << 1;
-    else if (consume("static", TK_IDENT) && ASSERT_STORAGE_SPECIFIER &&
+    else if (consume_keyword(KW_STATIC) && ASSERT_STORAGE_SPECIFIER &&
              CONSUMED_TRUE)
       *storage_class_specifier = 1 << 2;
-    else if (consume("auto", TK_IDENT) && ASSERT_STORAGE_SPECIFIER &&
+    else if (consume_keyword(KW_AUTO) && ASSERT_STORAGE_SPECIFIER &&
              CONSUMED_TRUE)
       *storage_class_specifier = 1 << 3;
-    else if (consume("register", TK_IDENT) && ASSERT_STORAGE_SPECIFIER &&
+    else if (consume_keyword(KW_REGISTER) && ASSERT_STORAGE_SPECIFIER &&
              CONSUMED_TRUE)
       *storage_class_specifier = 1 << 4;
-    else if (consume("const", TK_IDENT) && CONSUMED_TRUE)
+    else if (consume_keyword(KW_CONST) && CONSUMED_TRUE)
       const_count++;
-    else if (consume("restrict", TK_IDENT) && CONSUMED_TRUE)
+    else if (consume_keyword(KW_RESTRICT) && CONSUMED_TRUE)
       restrict_count++;
-    else if (consume("volatile", TK_IDENT) && CONSUMED_TRUE)
+    else if (consume_keyword(KW_VOLATILE) && CONSUMED_TRUE)
       volatile_count++;
-    else if (consume("inline", TK_IDENT) && CONSUMED_TRUE)
+    else if (consume_keyword(KW_INLINE) && CONSUMED_TRUE)
       if (inline_count)
         error_at(token->str, token->len,
                  "Multiple function-specifier (inline) declaration.");
       else
         inline_count++;
     else if (type == NULL &&
-             (peek("struct", TK_IDENT) || peek("union", TK_IDENT) ||
-              peek("enum", TK_IDENT)))
+             (peek_keyword(KW_STRUCT) || peek_keyword(KW_UNION) ||
+              peek_keyword(KW_ENUM)))
     {
       if (long_count || signed_count || unsigned_count || int_count ||
           bool_count || char_count || short_count || void_count)
         error_at(token->str, token->len, "Invalid type specifier.");
       consumed = true;
-      bool is_struct = consume("struct", TK_IDENT);
-      bool is_union = !is_struct && consume("union", TK_IDENT);
-      bool is_enum = !is_struct && !is_union && consume("enum", TK_IDENT);
+      bool is_struct = consume_keyword(KW_STRUCT);
+      bool is_union = !is_struct && consume_keyword(KW_UNION);
+      bool is_enum = !is_struct && !is_union && consume_keyword(KW_ENUM);
 
       Token* tag_name = consume_ident();
-      tag_list* new = NULL;
-      if (tag_name)
-      {
-        for (size_t i = 1; i <= vector_size(TagNamespaceList); i++)
-        {
-          Vector* tag_nest = vector_peek_at(TagNamespaceList, i);
-          for (size_t j = 1; j <= vector_size(tag_nest); j++)
-          {
-            tag_list* tmp = vector_peek_at(tag_nest, j);
-            if (tmp->name && tmp->name->len == tag_name->len &&
-                !strncmp(tmp->name->str, tag_name->str, tag_name->len))
-            {
-              if ((is_struct && tmp->tagkind != struct_type) ||
-                  (is_union && tmp->tagkind != union_type) ||
-                  (is_enum && tmp->tagkind != enum_type))
-                error_at(tag_name->str, tag_name->len, "Invalid type.");
-              new = tmp;
-              break;
-            }
-          }
-          if (new)
-            break;
-        }
-      }
-
+      tag_list* new = find_tag(tag_name);
       bool is_definition = consume("{", TK_RESERVED);
+      // A definition in an inner scope declares a new tag
+      if (is_definition && new && new->depth != vector_size(TagNamespaceList))
+        new = NULL;
+      if (new && ((is_struct && new->tagkind != struct_type) ||
+                  (is_union && new->tagkind != union_type) ||
+                  (is_enum && new->tagkind != enum_type)))
+        error_at(tag_name->str, tag_name->len, "Invalid type.");
       if (is_definition && new && new->data_list)
-      {
-        bool is_same_nest = false;
-        for (size_t i = 1; i <= vector_size(vector_peek(TagNamespaceList)); i++)
-        {
-          tag_list* tmp = vector_peek_at(vector_peek(TagNamespaceList), i);
-          if (tmp->name && tmp->name->len == tag_name->len &&
-              !strncmp(tmp->name->str, tag_name->str, tag_name->len))
-            is_same_nest = true;
-        }
-        if (is_same_nest)
-          error_at(get_old_token()->str, get_old_token()->len,
-                   "Multiple definition.");
-      }
+        error_at(get_old_token()->str, get_old_token()->len,
+                 "Multiple definition.");
       if (!new)
       {
         new = calloc(1, sizeof(tag_list));
@@ -234,7 +344,7 @@ Type* declaration_specifiers(uint8_t* storage_class_specifier)
         new->type = alloc_type(is_enum ? TYPE_ENUM : TYPE_STRUCT);
         new->type->type_num = ++tag_id;
         vector_push(EnumStructList, new);
-        vector_push(vector_peek(TagNamespaceList), new);
+        add_tag(new);
       }
 
       if (is_definition)
@@ -252,7 +362,7 @@ Type* declaration_specifiers(uint8_t* storage_class_specifier)
                        "Invalid enum definition.");
             tag_data_list* child = calloc(1, sizeof(tag_data_list));
             child->name = identifier;
-            child->type = alloc_type(TYPE_INT);
+            child->type = basic_type(TYPE_INT, false);
             ordinary_data_list* new_enum_member_name =
                 calloc(1, sizeof(ordinary_data_list));
             if (consume("=", TK_RESERVED))
@@ -268,9 +378,8 @@ Type* declaration_specifiers(uint8_t* storage_class_specifier)
             new_enum_member_name->ordinary_kind = enum_member_name;
             new_enum_member_name->enum_number = enum_num;
             new_enum_member_name->name = identifier;
-            new_enum_member_name->type = alloc_type(TYPE_INT);
-            vector_push(vector_peek(OrdinaryNamespaceList),
-                        new_enum_member_name);
+            new_enum_member_name->type = basic_type(TYPE_INT, false);
+            add_ordinary(new_enum_member_name);
             enum_num++;
             if (consume(",", TK_RESERVED))
               is_comma = true;
@@ -318,28 +427,29 @@ Type* declaration_specifiers(uint8_t* storage_class_specifier)
                         struct_alignment * struct_alignment;
           new->struct_size = struct_size;
           new->struct_alignment = struct_alignment;
+          build_member_index(new);
         }
       }
       type = new->type;
     }
     else if (type == NULL)
     {
-      if (consume("long", TK_IDENT) && CONSUMED_TRUE)
+      if (consume_keyword(KW_LONG) && CONSUMED_TRUE)
         long_count++;
-      else if (consume("signed", TK_IDENT) && CONSUMED_TRUE)
+      else if (consume_keyword(KW_SIGNED) && CONSUMED_TRUE)
         signed_count++;
-      else if (consume("unsigned", TK_IDENT) && CONSUMED_TRUE)
+      else if (consume_keyword(KW_UNSIGNED) && CONSUMED_TRUE)
         unsigned_count++;
-      else if (consume("int", TK_IDENT) && CONSUMED_TRUE)
+      else if (consume_keyword(KW_INT) && CONSUMED_TRUE)
         int_count++;
-      else if ((consume("bool", TK_IDENT) || consume("_Bool", TK_IDENT)) &&
+      else if ((consume_keyword(KW_BOOL) || consume_keyword(KW__BOOL)) &&
                CONSUMED_TRUE)
         bool_count++;
-      else if (consume("char", TK_IDENT) && CONSUMED_TRUE)
+      else if (consume_keyword(KW_CHAR) && CONSUMED_TRUE)
         char_count++;
-      else if (consume("short", TK_IDENT) && CONSUMED_TRUE)
+      else if (consume_keyword(KW_SHORT) && CONSUMED_TRUE)
         short_count++;
-      else if (consume("void", TK_IDENT) && CONSUMED_TRUE)
+      else if (consume_keyword(KW_VOID) && CONSUMED_TRUE)
         void_count++;
       else if (!(long_count || signed_count || unsigned_count || int_count ||
                  bool_count || char_count || short_count || void_count))
@@ -347,23 +457,7 @@ Type* declaration_specifiers(uint8_t* storage_class_specifier)
         Token* ident = peek_ident();
         if (ident)
         {
-          Type* found_type = NULL;
-          for (size_t i = vector_size(OrdinaryNamespaceList); i >= 1; i--)
-          {
-            Vector* typedef_nest = vector_peek_at(OrdinaryNamespaceList, i);
-            for (size_t j = 1; j <= vector_size(typedef_nest); j++)
-            {
-              ordinary_data_list* tmp = vector_peek_at(typedef_nest, j);
-              if (tmp->ordinary_kind == typedef_name && tmp->name &&
-                  tmp->name->len == ident->len &&
-                  !strncmp(tmp->name->str, ident->str, ident->len))
-              {
-                found_type = tmp->type;
-                goto found_typedef_in_loop;
-              }
-            }
-          }
-        found_typedef_in_loop:
+          Type* found_type = find_typedef_type(ident);
           if (found_type)
           {
             type = found_type;
@@ -421,20 +515,17 @@ Type* declaration_specifiers(uint8_t* storage_class_specifier)
     unreachable();
     kind = TYPE_NULL;
   }
-  type = alloc_type(kind);
-  if (!unsigned_count)
-    type->is_signed = true;
-  return type;
+  return basic_type(kind, !unsigned_count);
 }
 
 void add_typedef(Token* token, Type* type)
 {
   // Associate a name with a Type
-  ordinary_data_list* new = malloc(sizeof(ordinary_data_list));
+  ordinary_data_list* new = calloc(1, sizeof(ordinary_data_list));
   new->ordinary_kind = typedef_name;
   new->name = token;
   new->type = type;
-  vector_push(vector_peek(OrdinaryNamespaceList), new);
+  add_ordinary(new);
 }
 
 Var* add_variables(Token* token, Type* type, uint8_t storage_class_specifier)
@@ -450,9 +541,8 @@ Var* add_variables(Token* token, Type* type, uint8_t storage_class_specifier)
     return NULL;
   }
 
-  size_t data_num = 0;
   // Check if a variable with the same name already exists
-  ordinary_data_list* same = find_var_in_current_nested_block(token, &data_num);
+  ordinary_data_list* same = find_var_in_current_nested_block(token);
   if (same)
   {  // Check if the variable's storage class is extern
     if (!is_equal_type(type, same->type) ||
@@ -474,15 +564,21 @@ Var* add_variables(Token* token, Type* type, uint8_t storage_class_specifier)
   else
     var->is_local = true;  // The variable is a local variable
   var->storage_class_specifier = storage_class_specifier;
-  ordinary_data_list* new = calloc(1, sizeof(ordinary_data_list));
-  new->ordinary_kind = variables_name;
-  new->name = token;
-  new->variables = var;
-  new->type = type;
   if (same)
-    vector_replace_at(vector_peek(OrdinaryNamespaceList), data_num, new);
+  {  // The new declaration takes the place of the old one
+    same->ordinary_kind = variables_name;
+    same->variables = var;
+    same->type = type;
+  }
   else
-    vector_push(vector_peek(OrdinaryNamespaceList), new);
+  {
+    ordinary_data_list* new = calloc(1, sizeof(ordinary_data_list));
+    new->ordinary_kind = variables_name;
+    new->name = token;
+    new->variables = var;
+    new->type = type;
+    add_ordinary(new);
+  }
   if (storage_class_specifier & 1 << 1)
     return NULL;
   return var;
@@ -492,57 +588,75 @@ typedef struct literal_list literal_list;
 
 struct literal_list
 {
-  literal_list* next;
   char* literal_name;  // string identifier
   char* name;          // string
   size_t len;          // string len
+  uint32_t hash;       // hash of name
 };
 
-static literal_list* literal_top;
+// String literals are deduplicated through an open addressed hash table on
+// their spelling, grown to keep it at most half full
+#define LITERAL_TABLE_INITIAL_SIZE 256
+
+static literal_list** literal_table;
+static size_t literal_table_size;
 static size_t literal_counter;
 
+static void literal_table_grow()
+{
+  size_t new_size =
+      literal_table_size ? literal_table_size * 2 : LITERAL_TABLE_INITIAL_SIZE;
+  literal_list** new_table = calloc(new_size, sizeof(literal_list*));
+  for (size_t i = 0; i < literal_table_size; i++)
+  {
+    literal_list* literal = literal_table[i];
+    if (!literal)
+      continue;
+    size_t index = literal->hash & (new_size - 1);
+    while (new_table[index])
+      index = (index + 1) & (new_size - 1);
+    new_table[index] = literal;
+  }
+  free(literal_table);
+  literal_table = new_table;
+  literal_table_size = new_size;
+}
+
 // Used when assigning a string literal to a pointer
 char* add_string_literal(Token* token)
 {
   pr_debug2("string literal found");
+  if (literal_counter * 2 >= literal_table_size)
+    literal_table_grow();
   // If the same string already exists, use it
   // This is possible because the specification does not allow changing
   // strings
-  for (literal_list* pointer = literal_top; pointer; pointer = pointer->next)
-    if (token->len == pointer->len &&
+  uint32_t hash = atom_hash(token->str, token->len);
+  size_t mask = literal_table_size - 1;
+  size_t index = hash & mask;
+  for (literal_list* pointer; (pointer = literal_table[index]);
+       index = (index + 1) & mask)
+    if (pointer->hash == hash && token->len == pointer->len &&
         !strncmp(token->str, pointer->name, pointer->len))
       return pointer->literal_name;
   literal_list* new = calloc(1, sizeof(literal_list));
-  new->next = literal_top;
-  literal_top = new;
-  literal_top->name = token->str;
-  literal_top->len = token->len;
+  new->name = token->str;
+  new->len = token->len;
+  new->hash = hash;
+  literal_table[index] = new;
   // Determine the name of the string literal
-  // Up to 9999 string literals can exist
-  char* literal_name = malloc(8);
-  int snprintf_return = snprintf(literal_name, 8, ".LC%lu", literal_counter++);
-  if (snprintf_return < 3 || snprintf_return > 7)
-    unreachable();
+  int literal_name_len = snprintf(NULL, 0, ".LC%zu", literal_counter);
+  char* literal_name = malloc(literal_name_len + 1);
+  snprintf(literal_name, literal_name_len + 1, ".LC%zu", literal_counter++);
   pr_debug2("literal_name: %s", literal_name);
-  literal_top->literal_name = literal_name;
-  // Check if it does not exist as a global variable
-  for (size_t i = 1; i <= vector_size(vector_peek_at(OrdinaryNamespaceList, 1));
-       i++)
-  {
-    ordinary_data_list* tmp =
-        vector_peek_at(vector_peek_at(OrdinaryNamespaceList, 1), i);
-    if (tmp->ordinary_kind == variables_name && tmp->variables->len &&
-        !strncmp(tmp->variables->name, token->str, token->len))
-      unreachable();
-  }
+  new->literal_name = literal_name;
   Var* new_var = calloc(1, sizeof(Var));
   new_var->token = token;
   new_var->name = literal_name;
-  new_var->len = snprintf_return;
-  new_var->type = alloc_type(TYPE_STR);
+  new_var->len = literal_name_len;
+  new_var->type = basic_type(TYPE_STR, false);
   new_var->is_local = false;
   new_var->storage_class_specifier = 1 << 2;
-  vector_push(vector_peek_at(OrdinaryNamespaceList, 1), new_var);
   vector_push(StringList, new_var);
   return literal_name;
 }
@@ -557,37 +671,34 @@ bool add_function_name(Vector* function_list, Token* name,
 {
   if (storage_class_specifier & ~((1 << 1) + (1 << 2)))
     error_at(name->str, name->len, "Invalid storage class specifier.");
-  // Check if there is anything different with the same name in the namespace
-  for (size_t i = 1; i <= vector_size(OrdinaryNamespaceList); i++)
+  // Check if there is anything different with the same name in the namespace,
+  // taking the first declaration of the outermost scope
+  ordinary_data_list* tmp = NULL;
+  for (ordinary_data_list* data = find_ordinary(name); data;
+       data = data->shadowed)
+    if (!tmp || data->depth < tmp->depth)
+      tmp = data;
+  if (tmp)
   {
-    Vector* typedef_nest = vector_peek_at(OrdinaryNamespaceList, i);
-    for (size_t j = 1; j <= vector_size(typedef_nest); j++)
+    bool is_same = false;
+    if (tmp->ordinary_kind == function_name &&
+        vector_size(function_list) == vector_size(tmp->type->param_list))
     {
-      ordinary_data_list* tmp = vector_peek_at(typedef_nest, j);
-      if (tmp->name->len == name->len &&
-          !strncmp(tmp->name->str, name->str, name->len))
+      is_same = true;
+      for (size_t k = 1; k <= vector_size(tmp->type->param_list); k++)
       {
-        bool is_same = false;
-        if (tmp->ordinary_kind == function_name &&
-            vector_size(function_list) == vector_size(tmp->type->param_list))
+        if (!is_equal_type(vector_peek_at(function_list, k),
+                           vector_peek_at(tmp->type->param_list, k)))
         {
-          is_same = true;
-          for (size_t k = 1; k <= vector_size(tmp->type->param_list); k++)
-          {
-            if (!is_equal_type(vector_peek_at(function_list, k),
-                               vector_peek_at(tmp->type->param_list, k)))
-            {
-              is_same = false;
-              break;
-            }
-          }
+          is_same = false;
+          break;
         }
-        if (!is_same || (tmp->is_defined && is_defined))
-          return false;
-        else
-          return true;
       }
     }
+    if (!is_same || (tmp->is_defined && is_defined))
+      return false;
+    else
+      return true;
   }
   // If not, add it
   ordinary_data_list* new = calloc(1, sizeof(ordinary_data_list));
@@ -596,40 +707,30 @@ bool add_function_name(Vector* function_list, Token* name,
   new->is_defined = is_defined;
   new->type = alloc_type(TYPE_FUNC);
   new->type->param_list = function_list;
-  vector_push(vector_peek(OrdinaryNamespaceList), new);
+  add_ordinary(new);
   return true;
 }
 
 enum member_name is_enum_or_function_or_typedef_or_variables_name(
     Token* token, size_t* number, Type** type, Var** var)
 {
-  for (size_t i = vector_size(OrdinaryNamespaceList); i > 0; i--)
+  ordinary_data_list* tmp = find_ordinary(token);
+  if (!tmp)
+    return none_of_them;
+  if (type)
+    *type = tmp->type;
+  switch (tmp->ordinary_kind)
   {
-    Vector* typedef_nest = vector_peek_at(OrdinaryNamespaceList, i);
-    for (size_t j = 1; j <= vector_size(typedef_nest); j++)
-    {
-      ordinary_data_list* tmp = vector_peek_at(typedef_nest, j);
-      if (tmp->name->len == token->len &&
-          !strncmp(tmp->name->str, token->str, token->len))
-      {
-        if (type)
-          *type = tmp->type;
-        switch (tmp->ordinary_kind)
-        {
-          case enum_member_name:
-            if (number)
-              *number = tmp->enum_number;
-            return enum_member_name;
-          case variables_name:
-            if (var)
-              *var = tmp->variables;
-            return variables_name;
-          default: return tmp->ordinary_kind;
-        }
-      }
-    }
+    case enum_member_name:
+      if (number)
+        *number = tmp->enum_number;
+      return enum_member_name;
+    case variables_name:
+      if (var)
+        *var = tmp->variables;
+      return variables_name;
+    default: return tmp->ordinary_kind;
   }
-  return none_of_them;
 }
 
 // A function that creates a Type
@@ -640,6 +741,60 @@ Type* alloc_type(TypeKind kind)
   return new;
 }
 
+// Integer, void, string and variadic types, one per kind and signedness
+static Type* basic_types[TYPE_VARIABLES + 1][2];
+
+Type* basic_type(TypeKind kind, bool is_signed)
+{
+  Type** slot = &basic_types[kind][is_signed];
+  if (!*slot)
+  {
+    *slot = alloc_type(kind);
+    (*slot)->is_signed = is_signed;
+  }
+  return *slot;
+}
+
+// Pointers and arrays are interned in a hash table keyed on the type they
+// derive from, which is itself interned or unique, and the array size.
+#define DERIVED_TABLE_SIZE 1024
+
+static Type* derived_table[DERIVED_TABLE_SIZE];
+
+static Type* derived_type(TypeKind kind, Type* type, size_t size)
+{
+  size_t hash = ((uintptr_t)type >> 4) * 31 + size * 2 + (kind == TYPE_ARRAY);
+  Type** bucket = &derived_table[hash & (DERIVED_TABLE_SIZE - 1)];
+  for (Type* derived = *bucket; derived; derived = derived->next_derived)
+    if (derived->type == kind && derived->ptr_to == type &&
+        derived->size == size)
+      return derived;
+  Type* new = alloc_type(kind);
+  new->ptr_to = type;
+  new->size = size;
+  new->next_derived = *bucket;
+  *bucket = new;
+  return new;
+}
+
+Type* pointer_to(Type* type)
+{
+  return derived_type(TYPE_PTR, type, 0);
+}
+
+// An array of unknown size (size 0) is completed later by its initializer,
+// so it is not interned.
+Type* array_of(Type* type, size_t size)
+{
+  if (!size)
+  {
+    Type* new = alloc_type(TYPE_ARRAY);
+    new->ptr_to = type;
+    return new;
+  }
+  return derived_type(TYPE_ARRAY, type, size);
+}
+
 size_t size_of_real(TypeKind type)
 {
   switch (type)
@@ -658,8 +813,7 @@ size_t size_of_real(TypeKind type)
   }
 }
 
-// A function that takes a TYPE_INT, TYPE_ARRAY, etc. and returns its size
-size_t size_of(Type* type)
+static size_t size_of_uncached(Type* type)
 {
   switch (type->type)
   {
@@ -687,7 +841,20 @@ size_t size_of(Type* type)
   return 0;
 }
 
-size_t align_of(Type* type)
+// A function that takes a TYPE_INT, TYPE_ARRAY, etc. and returns its size
+// The size of a struct is looked up every time, as it is only known once the
+// struct is defined.
+size_t size_of(Type* type)
+{
+  if (type->byte_size)
+    return type->byte_size;
+  size_t size = size_of_uncached(type);
+  if (type->type != TYPE_STRUCT)
+    type->byte_size = size;
+  return size;
+}
+
+static size_t align_of_uncached(Type* type)
 {
   switch (type->type)
   {
@@ -707,6 +874,16 @@ size_t align_of(Type* type)
   return 0;
 }
 
+size_t align_of(Type* type)
+{
+  if (type->alignment)
+    return type->alignment;
+  size_t alignment = align_of_uncached(type);
+  if (type->type != TYPE_STRUCT)
+    type->alignment = alignment;
+  return alignment;
+}
+
 Type* find_struct_child_internal(Type* parent, Node* child, size_t* offset)
 {
   // Find the child of the struct and return its type
@@ -715,39 +892,22 @@ Type* find_struct_child_internal(Type* parent, Node* child, size_t* offset)
     parent = parent->ptr_to;
 
   tag_list* tmp = vector_peek_at(EnumStructList, parent->type_num);
-  if (tmp->type == parent)
+  if (tmp->type != parent)
+    unreachable();
+  if (!tmp->struct_size || !tmp->members)
+    return NULL;
+  // The index also holds the members of anonymous structs and unions
+  size_t mask = tmp->members_size - 1;
+  for (size_t i = child->token->atom->hash & mask; tmp->members[i];
+       i = (i + 1) & mask)
   {
-    if (tmp->struct_size)
+    tag_data_list* child_data = tmp->members[i];
+    if (child_data->name->atom == child->token->atom)
     {
-      Vector* child_list = tmp->data_list;
-      for (size_t k = 1; k <= vector_size(child_list); k++)
-      {
-        tag_data_list* child_data = vector_peek_at(child_list, k);
-        if (child_data->name)
-        {
-          if (child->token->len == child_data->name->len &&
-              !strncmp(child->token->str, child_data->name->str,
-                       child->token->len))
-          {
-            *offset = child_data->offset;
-            return child_data->type;
-          }
-        }
-        else
-        {  // For anonymous child struct
-          Type* result =
-              find_struct_child_internal(child_data->type, child, offset);
-          if (result)
-          {
-            *offset += child_data->offset;
-            return result;
-          }
-        }
-      }
+      *offset = child_data->offset;
+      return child_data->type;
     }
   }
-  else
-    unreachable();
   return NULL;
 }
 
@@ -783,11 +943,298 @@ void new_nest_type()
 
 void exit_nest_type()
 {
-  vector_pop(OrdinaryNamespaceList);
-  vector_pop(TagNamespaceList);
+  // The declarations of the closed scope are the first ones of their names
+  size_t depth = vector_size(OrdinaryNamespaceList);
+  Vector* scope = vector_pop(OrdinaryNamespaceList);
+  for (size_t i = 1; i <= vector_size(scope); i++)
+  {
+    ordinary_data_list* data = vector_peek_at(scope, i);
+    ordinary_data_list** head = &get_scoped_name(data->name->atom)->declarations;
+    while (*head && (*head)->depth == depth)
+      *head = (*head)->shadowed;
+  }
+  scope = vector_pop(TagNamespaceList);
+  for (size_t i = 1; i <= vector_size(scope); i++)
+  {
+    tag_list* tag = vector_peek_at(scope, i);
+    if (tag->name)
+      get_scoped_name(tag->name->atom)->tags = tag->shadowed;
+  }
 }
 
 Vector* get_enum_struct_list()
 {
   return EnumStructList;
 }
+
+// ------------------------------------------------------------------------------------
+// precompiled header
+// ------------------------------------------------------------------------------------
+
+// The file scope of a precompiled header is written after its tokens, as
+//
+//   tags      count, (tagkind, name, is_file_scope, is_defined, size,
+//             alignment) ...
+//   types     count, type ...
+//   members   (count, (name, type, offset) ...) for every defined tag
+//   names     count, (ordinary_kind, name, type, value) ...
+//
+// The tags are in the order of tag_id. The types are numbered from 1 in the
+// order written, 0 is NULL, and are written after the types they are made of:
+// (kind, is_signed) for the basic types, (TYPE_PTR, type),
+// (TYPE_ARRAY, type, size), (TYPE_STRUCT or TYPE_ENUM, tag_id) and
+// (TYPE_FUNC, count, type ...). The value of a name is the number of an enum
+// member, whether a function is defined or the storage class of a variable.
+
+#define PCH_TYPE_TABLE_SIZE 1024
+
+typedef struct pch_type pch_type;
+struct pch_type
+{
+  pch_type* next;  // Next type in the same bucket
+  Type* type;
+  size_t number;
+};
+
+static pch_type* pch_type_table[PCH_TYPE_TABLE_SIZE];
+static Vector* pch_types;  // Types in the order of their numbers
+
+static pch_type** find_pch_type(Type* type)
+{
+  pch_type** link =
+      &pch_type_table[((uintptr_t)type >> 4) & (PCH_TYPE_TABLE_SIZE - 1)];
+  while (*link && (*link)->type != type)
+    link = &(*link)->next;
+  return link;
+}
+
+// Number type and the types it is made of
+static void number_type(Type* type)
+{
+  pch_type** link = find_pch_type(type);
+  if (!type || *link)
+    return;
+  if (type->type == TYPE_PTR || type->type == TYPE_ARRAY)
+    number_type(type->ptr_to);
+  else if (type->type == TYPE_FUNC)
+    for (size_t i = 1; i <= vector_size(type->param_list); i++)
+      number_type(vector_peek_at(type->param_list, i));
+  // The recursion may have grown the bucket
+  link = find_pch_type(type);
+  *link = calloc(1, sizeof(pch_type));
+  (*link)->type = type;
+  vector_push(pch_types, type);
+  (*link)->number = vector_size(pch_types);
+}
+
+static void write_type_number(Type* type)
+{
+  pch_write_u32(type ? (*find_pch_type(type))->number : 0);
+}
+
+static void write_name(Token* name)
+{
+  if (name)
+    pch_write_string(name->str, name->len);
+  else
+    pch_write_string(NULL, 0);
+}
+
+void write_type_namespaces()
+{
+  Vector* names = vector_peek_at(OrdinaryNamespaceList, 1);
+  pch_types = vector_new();
+  for (size_t i = 1; i <= vector_size(EnumStructList); i++)
+  {
+    tag_list* tag = vector_peek_at(EnumStructList, i);
+    for (size_t j = 1; tag->data_list && j <= vector_size(tag->data_list); j++)
+      number_type(((tag_data_list*)vector_peek_at(tag->data_list, j))->type);
+  }
+  for (size_t i = 1; i <= vector_size(names); i++)
+    number_type(((ordinary_data_list*)vector_peek_at(names, i))->type);
+
+  pch_write_u32(vector_size(EnumStructList));
+  for (size_t i = 1; i <= vector_size(EnumStructList); i++)
+  {
+    tag_list* tag = vector_peek_at(EnumStructList, i);
+    pch_write_u32(tag->tagkind);
+    write_name(tag->name);
+    pch_write_u32(tag->depth == 1);
+    pch_write_u32(tag->data_list != NULL);
+    pch_write_u32(tag->struct_size);
+    pch_write_u32(tag->struct_alignment);
+  }
+
+  pch_write_u32(vector_size(pch_types));
+  for (size_t i = 1; i <= vector_size(pch_types); i++)
+  {
+    Type* type = vector_peek_at(pch_types, i);
+    pch_write_u32(type->type);
+    switch (type->type)
+    {
+      case TYPE_PTR: write_type_number(type->ptr_to); break;
+      case TYPE_ARRAY:
+        write_type_number(type->ptr_to);
+        pch_write_u32(type->size);
+        break;
+      case TYPE_STRUCT:
+      case TYPE_ENUM: pch_write_u32(type->type_num); break;
+      case TYPE_FUNC:
+        pch_write_u32(vector_size(type->param_list));
+        for (size_t j = 1; j <= vector_size(type->param_list); j++)
+          write_type_number(vector_peek_at(type->param_list, j));
+        break;
+      default: pch_write_u32(type->is_signed); break;
+    }
+  }
+
+  for (size_t i = 1; i <= vector_size(EnumStructList); i++)
+  {
+    tag_list* tag = vector_peek_at(EnumStructList, i);
+    if (!tag->data_list)
+      continue;
+    pch_write_u32(vector_size(tag->data_list));
+    for (size_t j = 1; j <= vector_size(tag->data_list); j++)
+    {
+      tag_data_list* member = vector_peek_at(tag->data_list, j);
+      write_name(member->name);
+      write_type_number(member->type);
+      pch_write_u32(member->offset);
+    }
+  }
+
+  pch_write_u32(vector_size(names));
+  for (size_t i = 1; i <= vector_size(names); i++)
+  {
+    ordinary_data_list* data = vector_peek_at(names, i);
+    pch_write_u32(data->ordinary_kind);
+    write_name(data->name);
+    write_type_number(data->type);
+    switch (data->ordinary_kind)
+    {
+      case enum_member_name: pch_write_u32(data->enum_number); break;
+      case function_name: pch_write_u32(data->is_defined); break;
+      case variables_name:
+        pch_write_u32(data->variables->storage_class_specifier);
+        break;
+      default: pch_write_u32(0); break;
+    }
+  }
+}
+
+void read_type_namespaces()
+{
+  size_t tag_count = pch_read_u32();
+  for (size_t i = 1; i <= tag_count; i++)
+  {
+    tag_list* tag = calloc(1, sizeof(tag_list));
+    tag->tagkind = pch_read_u32();
+    tag->name = pch_read_identifier();
+    tag->type = alloc_type(tag->tagkind == enum_type ? TYPE_ENUM : TYPE_STRUCT);
+    tag->type->type_num = ++tag_id;
+    vector_push(EnumStructList, tag);
+    if (pch_read_u32())  // The other tags are only reachable by their types
+      add_tag(tag);
+    if (pch_read_u32())
+      tag->data_list = vector_new();  // The members follow the types
+    tag->struct_size = pch_read_u32();
+    tag->struct_alignment = pch_read_u32();
+  }
+
+  size_t type_count = pch_read_u32();
+  Type** types = calloc(type_count + 1, sizeof(Type*));
+  for (size_t i = 1; i <= type_count; i++)
+  {
+    TypeKind kind = pch_read_u32();
+    size_t number;
+    switch (kind)
+    {
+      case TYPE_PTR:
+      case TYPE_ARRAY:
+        number = pch_read_u32();
+        if (number >= i)
+          error_exit("precompiled header is broken");
+        types[i] = kind == TYPE_PTR ? pointer_to(types[number])
+                                    : array_of(types[number], pch_read_u32());
+        break;
+      case TYPE_STRUCT:
+      case TYPE_ENUM:
+        number = pch_read_u32();
+        if (!number || number > tag_count)
+          error_exit("precompiled header is broken");
+        types[i] = ((tag_list*)vector_peek_at(EnumStructList, number))->type;
+        break;
+      case TYPE_FUNC:
+        types[i] = alloc_type(TYPE_FUNC);
+        types[i]->param_list = vector_new();
+        for (size_t count = pch_read_u32(); count; count--)
+        {
+          number = pch_read_u32();
+          if (number >= i)
+            error_exit("precompiled header is broken");
+          vector_push(types[i]->param_list, types[number]);
+        }
+        break;
+      default:
+        if (kind > TYPE_VARIABLES)
+          error_exit("precompiled header is broken");
+        types[i] = basic_type(kind, pch_read_u32());
+        break;
+    }
+  }
+
+  for (size_t i = 1; i <= tag_count; i++)
+  {
+    tag_list* tag = vector_peek_at(EnumStructList, i);
+    if (!tag->data_list)
+      continue;
+    for (size_t count = pch_read_u32(); count; count--)
+    {
+      tag_data_list* member = malloc(sizeof(tag_data_list));
+      member->name = pch_read_identifier();
+      size_t number = pch_read_u32();
+      if (number > type_count)
+        error_exit("precompiled header is broken");
+      member->type = types[number];
+      member->offset = pch_read_u32();
+      vector_push(tag->data_list, member);
+    }
+  }
+  // The members of anonymous structs and unions are indexed with their parent
+  for (size_t i = 1; i <= tag_count; i++)
+  {
+    tag_list* tag = vector_peek_at(EnumStructList, i);
+    if (tag->data_list && tag->tagkind != enum_type)
+      build_member_index(tag);
+  }
+
+  for (size_t count = pch_read_u32(); count; count--)
+  {
+    ordinary_data_list* data = calloc(1, sizeof(ordinary_data_list));
+    data->ordinary_kind = pch_read_u32();
+    data->name = pch_read_identifier();
+    size_t number = pch_read_u32();
+    if (data->ordinary_kind >= none_of_them || !data->name ||
+        number > type_count)
+      error_exit("precompiled header is broken");
+    data->type = types[number];
+    size_t value = pch_read_u32();
+    if (data->ordinary_kind == enum_member_name)
+      data->enum_number = value;
+    else if (data->ordinary_kind == function_name)
+      data->is_defined = value;
+    else if (data->ordinary_kind == variables_name)
+    {
+      Var* var = calloc(1, sizeof(Var));
+      var->token = data->name;
+      var->name = data->name->str;
+      var->len = data->name->len;
+      var->type = data->type;
+      var->is_local = false;
+      var->storage_class_specifier = value;
+      data->variables = var;
+    }
+    add_ordinary(data);
+  }
+  free(types);
+}